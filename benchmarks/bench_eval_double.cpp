@@ -7,9 +7,17 @@
 #include <symengine/mul.h>
 #include <symengine/pow.h>
 #include <symengine/eval_double.h>
+#include <symengine/bytecode_double.h>
+#include <symengine/lambda_double.h>
+#include <symengine/llvm_double.h>
 
 using SymEngine::Basic;
+using SymEngine::BytecodeRealDoubleVisitor;
 using SymEngine::integer;
+using SymEngine::LambdaRealDoubleVisitor;
+#ifdef HAVE_SYMENGINE_LLVM
+using SymEngine::LLVMDoubleVisitor;
+#endif
 using SymEngine::RCP;
 using SymEngine::symbol;
 
@@ -55,8 +63,118 @@ void eval_double_single_dispatch(benchmark::State &state)
     state.SetComplexityN(state.range(0));
 }
 
+// Expression in `x` and `y` with the same structure as above
+RCP<const Basic> get_lambda_double_expression(int n)
+{
+    RCP<const Basic> x = symbol("x"), y = symbol("y");
+    RCP<const Basic> e = sin(x);
+
+    for (int i = 0; i < n; i++) {
+        e = add(mul(add(e, pow(y, integer(2))), integer(3)), mul(x, y));
+    }
+    return e;
+}
+
+// Evaluation at 1024 points, one point per call
+void lambda_double_call(benchmark::State &state)
+{
+    auto e = get_lambda_double_expression(state.range(0));
+    LambdaRealDoubleVisitor v;
+    v.init({symbol("x"), symbol("y")}, *e);
+    const int n = 1024;
+    std::vector<double> x(2 * n, 0.5), r(n);
+    for (auto _ : state) {
+        for (int k = 0; k < n; k++) {
+            double p[] = {x[k], x[n + k]};
+            v.call(&r[k], p);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(state.range(0));
+}
+
+// Evaluation at 1024 points with a single call_batch()
+void lambda_double_call_batch(benchmark::State &state)
+{
+    auto e = get_lambda_double_expression(state.range(0));
+    LambdaRealDoubleVisitor v;
+    v.init({symbol("x"), symbol("y")}, *e);
+    const int n = 1024;
+    std::vector<double> x(2 * n, 0.5), r(n);
+    for (auto _ : state) {
+        v.call_batch(r.data(), x.data(), n, n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(state.range(0));
+}
+
+// Evaluation at 1024 points, one point per call
+void bytecode_double_call(benchmark::State &state)
+{
+    auto e = get_lambda_double_expression(state.range(0));
+    BytecodeRealDoubleVisitor v;
+    v.init({symbol("x"), symbol("y")}, *e);
+    const int n = 1024;
+    std::vector<double> x(2 * n, 0.5), r(n);
+    for (auto _ : state) {
+        for (int k = 0; k < n; k++) {
+            double p[] = {x[k], x[n + k]};
+            v.call(&r[k], p);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(state.range(0));
+}
+
+#ifdef HAVE_SYMENGINE_LLVM
+// Evaluation at 1024 points, one point per call
+void llvm_double_call(benchmark::State &state)
+{
+    auto e = get_lambda_double_expression(state.range(0));
+    LLVMDoubleVisitor v;
+    v.init({symbol("x"), symbol("y")}, *e);
+    const int n = 1024;
+    std::vector<double> x(2 * n, 0.5), r(n);
+    for (auto _ : state) {
+        for (int k = 0; k < n; k++) {
+            double p[] = {x[k], x[n + k]};
+            v.call(&r[k], p);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(state.range(0));
+}
+
+// Evaluation at 1024 points with the vectorized loop
+void llvm_double_call_batch(benchmark::State &state)
+{
+    auto e = get_lambda_double_expression(state.range(0));
+    LLVMDoubleVisitor v;
+    v.init({symbol("x"), symbol("y")}, {e}, false, 3, true);
+    const int n = 1024;
+    std::vector<double> x(2 * n, 0.5), r(n);
+    for (auto _ : state) {
+        v.call_batch(r.data(), x.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(state.range(0));
+}
+#endif
+
 BENCHMARK(eval_double)->Range(1 << 1, 1 << 14)->Complexity();
 BENCHMARK(eval_double_visitor_pattern)->Range(1 << 1, 1 << 14)->Complexity();
 BENCHMARK(eval_double_single_dispatch)->Range(1 << 1, 1 << 14)->Complexity();
+BENCHMARK(lambda_double_call)->Range(1 << 1, 1 << 8)->Complexity();
+BENCHMARK(lambda_double_call_batch)->Range(1 << 1, 1 << 8)->Complexity();
+BENCHMARK(bytecode_double_call)->Range(1 << 1, 1 << 8)->Complexity();
+#ifdef HAVE_SYMENGINE_LLVM
+BENCHMARK(llvm_double_call)->Range(1 << 1, 1 << 8)->Complexity();
+BENCHMARK(llvm_double_call_batch)->Range(1 << 1, 1 << 8)->Complexity();
+#endif
 
 BENCHMARK_MAIN();
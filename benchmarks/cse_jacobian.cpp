@@ -0,0 +1,77 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include <symengine/basic.h>
+#include <symengine/add.h>
+#include <symengine/symbol.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/functions.h>
+#include <symengine/matrix.h>
+
+using SymEngine::add;
+using SymEngine::Basic;
+using SymEngine::CSRMatrix;
+using SymEngine::div;
+using SymEngine::exp;
+using SymEngine::mul;
+using SymEngine::neg;
+using SymEngine::RCP;
+using SymEngine::symbol;
+using SymEngine::vec_basic;
+using SymEngine::vec_pair;
+using SymEngine::vec_sym;
+
+// Nonzero entries of the jacobian of a mass action reaction network with `n`
+// species and `4 n` reactions between pseudo-random species
+vec_basic kinetics_jacobian(unsigned n)
+{
+    vec_sym x;
+    for (unsigned i = 0; i < n; i++) {
+        x.push_back(symbol("x" + std::to_string(i)));
+    }
+    RCP<const Basic> arrhenius = exp(div(symbol("E"), symbol("T")));
+    std::vector<vec_basic> terms(n);
+    unsigned long long seed = 12345;
+    auto next = [&]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<unsigned>(seed >> 33) % n;
+    };
+    for (unsigned r = 0; r < 4 * n; r++) {
+        unsigned a = next(), b = next(), c = next();
+        RCP<const Basic> rate = mul(
+            {symbol("k" + std::to_string(r)), x[a], x[b], arrhenius});
+        terms[a].push_back(neg(rate));
+        terms[b].push_back(neg(rate));
+        terms[c].push_back(rate);
+    }
+    vec_basic f;
+    for (const auto &t : terms) {
+        f.push_back(add(t));
+    }
+    return std::get<2>(CSRMatrix::jacobian(f, x).as_vectors());
+}
+
+int main(int argc, char *argv[])
+{
+    SymEngine::print_stack_on_segfault();
+    unsigned n = 4000;
+    if (argc > 1) {
+        n = std::atoi(argv[1]);
+    }
+
+    vec_basic exprs = kinetics_jacobian(n);
+    vec_pair replacements;
+    vec_basic reduced_exprs;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    cse(replacements, reduced_exprs, exprs);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "cse of " << exprs.size() << " jacobian entries ("
+              << replacements.size() << " replacements) : \t "
+              << std::setw(15) << std::setprecision(9) << std::fixed
+              << std::chrono::duration<double>(t2 - t1).count() << std::endl;
+
+    return 0;
+}
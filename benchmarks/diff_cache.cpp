@@ -9,11 +9,14 @@
 #include <symengine/mul.h>
 #include <symengine/pow.h>
 #include <symengine/functions.h>
+#include <symengine/matrix.h>
 
 using SymEngine::add;
 using SymEngine::Basic;
+using SymEngine::DenseMatrix;
 using SymEngine::integer;
 using SymEngine::log;
+using SymEngine::mul;
 using SymEngine::pow;
 using SymEngine::RCP;
 using SymEngine::rcp_static_cast;
@@ -21,6 +24,7 @@ using SymEngine::sin;
 using SymEngine::sqrt;
 using SymEngine::symbol;
 using SymEngine::Symbol;
+using SymEngine::vec_basic;
 
 double CommonSubexprDiff(bool cache)
 {
@@ -72,6 +76,42 @@ double NoCommonSubexprDiff(bool cache)
     return std::chrono::duration<double>(t2 - t1).count();
 }
 
+// Jacobian of a vector whose entries share a common subexpression, computed
+// either entry by entry or with the matrix level `jacobian`
+double JacobianDiff(bool matrix)
+{
+    unsigned n = 20;
+    vec_basic v;
+    std::string tmp_str = "a";
+    for (unsigned i = 0; i < n; ++i) {
+        v.push_back(symbol(tmp_str));
+        tmp_str += "a";
+    }
+
+    RCP<const Basic> e = integer(23);
+    for (unsigned int i = 0; i < n; ++i) {
+        e = add(e, cos(sqrt(log(sin(pow(v[n - i - 1], v[i]))))));
+    }
+    DenseMatrix A(n, 1), X(n, 1, v), J(n, n);
+    for (unsigned i = 0; i < n; ++i) {
+        A.set(i, 0, mul(v[i], pow(e, integer(i + 1))));
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    if (matrix) {
+        jacobian(A, X, J);
+    } else {
+        for (unsigned j = 0; j < n; ++j) {
+            RCP<const Symbol> x = rcp_static_cast<const Symbol>(v[j]);
+            for (unsigned i = 0; i < n; ++i) {
+                J.set(i, j, A.get(i, 0)->diff(x));
+            }
+        }
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t2 - t1).count();
+}
+
 int main(int argc, char *argv[])
 {
     SymEngine::print_stack_on_segfault();
@@ -90,6 +130,12 @@ int main(int argc, char *argv[])
         << "Time for expr without common subexpressions (without cache) : \t "
         << std::setw(15) << std::setprecision(9) << std::fixed
         << NoCommonSubexprDiff(false) << std::endl;
+    std::cout << "Time for jacobian (entry by entry) : \t "
+              << std::setw(15) << std::setprecision(9) << std::fixed
+              << JacobianDiff(false) << std::endl;
+    std::cout << "Time for jacobian (shared cache) : \t "
+              << std::setw(15) << std::setprecision(9) << std::fixed
+              << JacobianDiff(true) << std::endl;
 
     return 0;
 }
@@ -35,6 +35,31 @@ int main(int argc, char *argv[])
         mul_dense_dense(A, B, C);
     auto t2 = std::chrono::high_resolution_clock::now();
 
+    std::cout << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
+                         .count()
+                     / N
+              << " microseconds" << std::endl;
+
+    unsigned n = 40;
+    DenseMatrix D(n, n), E(n, n), F(n, n);
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned j = 0; j < n; j++) {
+            D.set(i, j,
+                  symbol("a_" + std::to_string(i) + "_" + std::to_string(j)));
+            E.set(i, j,
+                  symbol("b_" + std::to_string(i) + "_" + std::to_string(j)));
+        }
+    }
+
+    std::cout << "Multiplying Two Matrices; matrix dimensions: " << n << " x "
+              << n << std::endl;
+
+    N = 10;
+    t1 = std::chrono::high_resolution_clock::now();
+    for (unsigned i = 0; i < N; i++)
+        mul_dense_dense(D, E, F);
+    t2 = std::chrono::high_resolution_clock::now();
+
     std::cout << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
                          .count()
                      / N
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/polys/msymenginepoly.h>
+
+using SymEngine::MIntPoly;
+using SymEngine::RCP;
+using SymEngine::symbol;
+using SymEngine::vec_basic;
+
+using namespace SymEngine::literals;
+
+// Multiplies MIntPolys: a dense one, f*(f + 1) with f = (1 + x + y + z + t)**N
+// (Fateman's benchmark), and a sparse one, g*h with
+// g = (1 + x + y**2 + z**3 + t**5)**N and h = (1 + t + z**2 + y**3 + x**5)**N
+int main(int argc, char *argv[])
+{
+    SymEngine::print_stack_on_segfault();
+    unsigned N;
+    if (argc == 2) {
+        N = std::atoi(argv[1]);
+    } else {
+        N = 10;
+    }
+
+    vec_basic v = {symbol("x"), symbol("y"), symbol("z"), symbol("t")};
+    RCP<const MIntPoly> f = MIntPoly::from_dict(v, {{{0, 0, 0, 0}, 1_z},
+                                                    {{1, 0, 0, 0}, 1_z},
+                                                    {{0, 1, 0, 0}, 1_z},
+                                                    {{0, 0, 1, 0}, 1_z},
+                                                    {{0, 0, 0, 1}, 1_z}});
+    RCP<const MIntPoly> one = MIntPoly::from_dict(v, {{{0, 0, 0, 0}, 1_z}});
+    RCP<const MIntPoly> g = MIntPoly::from_dict(v, {{{0, 0, 0, 0}, 1_z},
+                                                    {{1, 0, 0, 0}, 1_z},
+                                                    {{0, 2, 0, 0}, 1_z},
+                                                    {{0, 0, 3, 0}, 1_z},
+                                                    {{0, 0, 0, 5}, 1_z}});
+    RCP<const MIntPoly> h = MIntPoly::from_dict(v, {{{0, 0, 0, 0}, 1_z},
+                                                    {{0, 0, 0, 1}, 1_z},
+                                                    {{0, 0, 2, 0}, 1_z},
+                                                    {{0, 3, 0, 0}, 1_z},
+                                                    {{5, 0, 0, 0}, 1_z}});
+    f = pow_mpoly(*f, N);
+    g = pow_mpoly(*g, N);
+    h = pow_mpoly(*h, N);
+    RCP<const MIntPoly> f1 = add_mpoly(*f, *one);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    RCP<const MIntPoly> r = mul_mpoly(*f, *f1);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "dense:  "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1)
+                     .count()
+              << "ms, " << r->get_poly().dict_.size() << " terms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    r = mul_mpoly(*g, *h);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "sparse: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1)
+                     .count()
+              << "ms, " << r->get_poly().dict_.size() << " terms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/fields.h>
+#include <symengine/polys/uintpoly.h>
+
+using SymEngine::GaloisFieldDict;
+using SymEngine::integer_class;
+using SymEngine::RCP;
+using SymEngine::symbol;
+using SymEngine::UIntDict;
+using SymEngine::UIntPoly;
+using SymEngine::vec_integer_class;
+
+// Evaluation of a polynomial of degree N - 1 at N points and interpolation
+// back from the values, over GF(2^31 - 1) and over the integers (where the
+// evaluation uses Horner's scheme)
+int main(int argc, char *argv[])
+{
+    SymEngine::print_stack_on_segfault();
+    unsigned N;
+    if (argc == 2) {
+        N = std::atoi(argv[1]);
+    } else {
+        N = 10000;
+    }
+
+    const integer_class p(2147483647);
+    vec_integer_class v(N), pts(N), small(N);
+    UIntDict a;
+    integer_class c(1);
+    for (unsigned i = 0; i < N; i++) {
+        c = (c * 1103515245 + 12345) % p;
+        v[i] = c;
+        if (i < N / 10)
+            a.dict_[i] = 2 * (c % 1000) - 999;
+        pts[i] = integer_class(i) * 7919 + 13;
+        small[i] = integer_class(i) - integer_class(N / 20);
+    }
+    GaloisFieldDict f = GaloisFieldDict::from_vec(v, p);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    vec_integer_class vals(N);
+    for (unsigned i = 0; i < N; i++)
+        vals[i] = f.gf_eval(pts[i]);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "GF(p) Horner:           "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1)
+                     .count()
+              << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    vals = f.gf_multi_eval(pts);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "GF(p) gf_multi_eval:    "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1)
+                     .count()
+              << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    GaloisFieldDict g = GaloisFieldDict::gf_interpolate(pts, vals, p);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "GF(p) gf_interpolate:   "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1)
+                     .count()
+              << "ms" << (g == f ? "" : " (wrong)") << std::endl;
+
+    // The integer values grow with N, so smaller sizes are used there
+    const unsigned M = N / 10;
+    small.resize(M);
+    RCP<const UIntPoly> ap = UIntPoly::from_container(symbol("x"), UIntDict(a));
+
+    t1 = std::chrono::high_resolution_clock::now();
+    vals = ap->multieval(small);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "Z multieval:            "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1)
+                     .count()
+              << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    UIntDict b = UIntDict::interpolate(small, vals);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "Z interpolate:          "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1)
+                     .count()
+              << "ms" << (b == a ? "" : " (wrong)") << std::endl;
+
+    return 0;
+}
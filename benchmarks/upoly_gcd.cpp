@@ -0,0 +1,74 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/polys/uintpoly.h>
+#include <symengine/polys/uintpoly_flint.h>
+
+using SymEngine::Basic;
+using SymEngine::integer_class;
+using SymEngine::map_uint_mpz;
+using SymEngine::RCP;
+using SymEngine::symbol;
+using SymEngine::UIntDict;
+using SymEngine::UIntPoly;
+#ifdef HAVE_SYMENGINE_FLINT
+using SymEngine::UIntPolyFlint;
+#endif
+
+// gcd(f*g, f*h) for dense polynomials of degree N with coefficients of about
+// 20 bits
+int main(int argc, char *argv[])
+{
+    SymEngine::print_stack_on_segfault();
+    unsigned N;
+    if (argc == 2) {
+        N = std::atoi(argv[1]);
+    } else {
+        N = 100;
+    }
+
+    map_uint_mpz f, g, h;
+    integer_class c(1);
+    for (unsigned i = 0; i <= N; i++) {
+        c = (c * 1103515245 + 12345) % 1000003;
+        f[i] = c - 500000;
+        c = (c * 1103515245 + 12345) % 1000003;
+        g[i] = c - 500000;
+        c = (c * 1103515245 + 12345) % 1000003;
+        h[i] = c - 500000;
+    }
+    UIntDict a = UIntDict(f) * UIntDict(g), b = UIntDict(f) * UIntDict(h), r;
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    bool ok = UIntDict::gcd_heu(a, b, r);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "gcd_heu:     "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
+                     .count()
+              << "us" << (ok ? "" : " (failed)") << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    r = UIntDict::gcd_modular(a, b);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "gcd_modular: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
+                     .count()
+              << "us" << std::endl;
+
+#ifdef HAVE_SYMENGINE_FLINT
+    RCP<const Basic> x = symbol("x");
+    RCP<const UIntPolyFlint> fa
+        = UIntPolyFlint::from_poly(*UIntPoly::from_container(x, std::move(a)));
+    RCP<const UIntPolyFlint> fb
+        = UIntPolyFlint::from_poly(*UIntPoly::from_container(x, std::move(b)));
+    t1 = std::chrono::high_resolution_clock::now();
+    RCP<const UIntPolyFlint> fr = gcd_upoly(*fa, *fb);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "flint:       "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
+                     .count()
+              << "us" << std::endl;
+#endif
+
+    return 0;
+}
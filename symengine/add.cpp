@@ -183,8 +183,8 @@ RCP<const Basic> Add::from_dict(const RCP<const Number> &coef,
             } else {
                 insert(m, p->first, one);
             }
-            return make_rcp<const Mul>(p->second,
-                                       std::move(m)); // Returns a Mul from here
+            return intern(make_rcp<const Mul>(
+                p->second, std::move(m))); // Returns a Mul from here
         }
         map_basic_basic m;
         if (is_a_Number(*p->second)) {
@@ -218,14 +218,15 @@ RCP<const Basic> Add::from_dict(const RCP<const Number> &coef,
             } else {
                 insert(m, p->first, one);
             }
-            return make_rcp<const Mul>(p->second, std::move(m));
+            return intern(make_rcp<const Mul>(p->second, std::move(m)));
         } else {
             insert(m, p->first, one);
             insert(m, p->second, one);
-            return make_rcp<const Mul>(one, std::move(m));
+            return intern(make_rcp<const Mul>(one, std::move(m)));
         }
     } else {
-        return make_rcp<const Add>(coef, std::move(d)); // returns an Add
+        // returns an Add
+        return intern(make_rcp<const Add>(coef, std::move(d)));
     }
 }
 
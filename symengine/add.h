@@ -138,6 +138,19 @@ public:
      */
     vec_basic get_args() const override;
 
+    /**
+     * @brief Calls `f(coef, term)` for every `coef*term` of the dictionary.
+     * @details Together with `get_coef()` this visits all the terms of the
+     * Add without constructing any objects, unlike `get_args()`.
+     */
+    template <typename F>
+    inline void for_each_term(F &&f) const
+    {
+        for (const auto &p : dict_) {
+            f(p.second, p.first);
+        }
+    }
+
     //!< @return const reference to the coefficient of the `Add`.
     inline const RCP<const Number> &get_coef() const
     {
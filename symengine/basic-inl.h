@@ -11,6 +11,18 @@ inline hash_t Basic::hash() const
     return hash_;
 }
 
+inline hash_t symbol_signature_bit(const Basic &x)
+{
+    return hash_t(1) << (x.hash() % 63);
+}
+
+inline hash_t Basic::symbol_signature() const
+{
+    if (symbols_ == 0)
+        symbols_ = compute_symbol_signature();
+    return symbols_;
+}
+
 //! \return true if not equal
 inline bool Basic::__neq__(const Basic &o) const
 {
@@ -31,6 +43,21 @@ inline bool neq(const Basic &a, const Basic &b)
     return not(a.__eq__(b));
 }
 
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+extern std::atomic<bool> interning_enabled_;
+#else
+extern bool interning_enabled_;
+#endif
+
+//! Returns `x` or the interned instance equal to it if interning is enabled
+template <class T>
+inline RCP<const T> intern(RCP<const T> &&x)
+{
+    if (not interning_enabled_)
+        return std::move(x);
+    return rcp_static_cast<const T>(intern_basic(x));
+}
+
 //! Templatised version to check is_a type
 template <class T>
 inline bool is_a(const Basic &b)
@@ -2,6 +2,9 @@
 #include <symengine/subs.h>
 #include <symengine/serialize-cereal.h>
 #include <array>
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+#include <mutex>
+#endif
 
 namespace SymEngine
 {
@@ -43,6 +46,31 @@ int Basic::__cmp__(const Basic &o) const
     }
 }
 
+hash_t Basic::compute_symbol_signature() const
+{
+    if (is_a_sub<Symbol>(*this)) {
+        return symbol_free_signature | symbol_signature_bit(*this);
+    }
+    // Subs binds its variables and polynomials, series, etc. keep their
+    // generators outside of get_args(), so be conservative for them
+    if (is_a<Subs>(*this)) {
+        return ~hash_t(0);
+    }
+    vec_basic args = get_args();
+    if (args.empty()) {
+        if (is_a_Number(*this) or is_a<Constant>(*this)
+            or is_a<BooleanAtom>(*this)) {
+            return symbol_free_signature;
+        }
+        return ~hash_t(0);
+    }
+    hash_t sig = symbol_free_signature;
+    for (const auto &p : args) {
+        sig |= p->symbol_signature();
+    }
+    return sig;
+}
+
 std::string Basic::__str__() const
 {
     return str(*this);
@@ -92,6 +120,83 @@ const char *get_version()
     return SYMENGINE_VERSION;
 }
 
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+std::atomic<bool> interning_enabled_{false};
+#else
+bool interning_enabled_ = false;
+#endif
+
+namespace
+{
+uset_basic &intern_table()
+{
+    static uset_basic table;
+    return table;
+}
+
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+std::mutex &intern_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+#define SYMENGINE_INTERN_LOCK()                                                \
+    std::lock_guard<std::mutex> intern_lock(intern_mutex())
+#else
+#define SYMENGINE_INTERN_LOCK()
+#endif
+} // namespace
+
+void set_interning(bool enable)
+{
+    interning_enabled_ = enable;
+}
+
+bool is_interning()
+{
+    return interning_enabled_;
+}
+
+RCP<const Basic> intern_basic(const RCP<const Basic> &x)
+{
+    SYMENGINE_INTERN_LOCK();
+    return *intern_table().insert(x).first;
+}
+
+void intern_collect()
+{
+    SYMENGINE_INTERN_LOCK();
+    uset_basic &table = intern_table();
+    // Releasing a node can leave its arguments referenced only by the table,
+    // so sweep until nothing more can be removed.
+    bool removed = true;
+    while (removed) {
+        removed = false;
+        for (auto it = table.begin(); it != table.end();) {
+            if ((*it)->use_count() == 1) {
+                it = table.erase(it);
+                removed = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void intern_clear()
+{
+    SYMENGINE_INTERN_LOCK();
+    intern_table().clear();
+}
+
+size_t intern_table_size()
+{
+    SYMENGINE_INTERN_LOCK();
+    return intern_table().size();
+}
+
+#undef SYMENGINE_INTERN_LOCK
+
 bool is_a_Atom(const Basic &b)
 {
     return is_a_Number(b) or is_a<Symbol>(b) or is_a<Constant>(b);
@@ -101,11 +101,16 @@ private:
 // in the constructor and then it can be changed in Basic::hash() to the
 // current hash (which is always the same for the given instance). The
 // state of the instance does not change, so we define hash_ as mutable.
+// The symbols_ signature is cached in the same way.
 #if defined(WITH_SYMENGINE_THREAD_SAFE)
     mutable std::atomic<hash_t> hash_; // This holds the hash value
+    mutable std::atomic<hash_t> symbols_; // This holds the symbol signature
 #else
     mutable hash_t hash_; // This holds the hash value
+    mutable hash_t symbols_; // This holds the symbol signature
 #endif // WITH_SYMENGINE_THREAD_SAFE
+    hash_t compute_symbol_signature() const;
+
 public:
 #ifdef WITH_SYMENGINE_VIRTUAL_TYPEID
     virtual TypeID get_type_code() const = 0;
@@ -117,7 +122,7 @@ public:
     };
 #endif
     //! Constructor
-    Basic() : hash_{0} {}
+    Basic() : hash_{0}, symbols_{0} {}
     // Destructor must be explicitly defined as virtual here to avoid problems
     // with undefined behavior while deallocating derived classes.
     virtual ~Basic() {}
@@ -152,6 +157,14 @@ public:
      */
     hash_t hash() const;
 
+    /** Returns a 64-bit Bloom signature of the symbols in the expression tree:
+     *   `symbol_signature_bit(x)` is set for every `Symbol` `x` that occurs in
+     *   it, so a missing bit proves that `x` does not occur. Nodes whose
+     *   symbols are not all reachable through `get_args()` set every bit.
+     *   This method caches the value.
+     */
+    hash_t symbol_signature() const;
+
     /**
      * @brief Test equality
      *
@@ -206,6 +219,12 @@ public:
     RCP<const Basic> diff(const RCP<const Symbol> &x, bool cache = true) const;
 };
 
+//! Bit of `Basic::symbol_signature()` that is set by the Symbol `x`
+hash_t symbol_signature_bit(const Basic &x);
+
+//! `Basic::symbol_signature()` of an expression without any symbols
+const hash_t symbol_free_signature = hash_t(1) << 63;
+
 //! Our hash:
 struct RCPBasicHash {
     //! Returns the hashed value.
@@ -266,8 +285,10 @@ bool is_a_sub(const Basic &b);
 //! Returns true if `a` and `b` are exactly the same type `T`.
 bool is_same_type(const Basic &a, const Basic &b);
 
-//! Expands `self`
-RCP<const Basic> expand(const RCP<const Basic> &self, bool deep = true);
+/*! Expands `self`. With `nthreads > 1` and OpenMP enabled, the terms of the
+    multinomial expansion of powers of sums are computed in parallel. */
+RCP<const Basic> expand(const RCP<const Basic> &self, bool deep = true,
+                        unsigned nthreads = 1);
 void as_numer_denom(const RCP<const Basic> &x,
                     const Ptr<RCP<const Basic>> &numer,
                     const Ptr<RCP<const Basic>> &denom);
@@ -284,6 +305,27 @@ RCP<const Basic> rewrite_as_cos(const RCP<const Basic> &x);
 void cse(vec_pair &replacements, vec_basic &reduced_exprs,
          const vec_basic &exprs);
 
+/*! Hash-consing ("interning") of canonical `Symbol`, `Add`, `Mul` and `Pow`
+    nodes. When enabled, `symbol()`, `add()`, `mul()`, `pow()` and the
+    `from_dict()` constructors return the already existing instance for a
+    structurally equal result, so that equal subexpressions share one node and
+    `eq()` succeeds on the pointer comparison. Disabled by default.
+
+    The intern table holds a reference to every node it contains, use
+    `intern_collect()` to release the nodes that are not used elsewhere.
+*/
+void set_interning(bool enable);
+//! Returns true if interning of newly constructed nodes is enabled
+bool is_interning();
+//! Returns the canonical instance equal to `x`, inserting `x` if not present
+RCP<const Basic> intern_basic(const RCP<const Basic> &x);
+//! Removes the nodes that are referenced only by the intern table
+void intern_collect();
+//! Removes all nodes from the intern table
+void intern_clear();
+//! Returns the number of nodes in the intern table
+size_t intern_table_size();
+
 /*! This `<<` overloaded function simply calls `p.__str__`, so it allows any
    Basic
     type to be printed.
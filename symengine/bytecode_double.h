@@ -0,0 +1,848 @@
+#ifndef SYMENGINE_BYTECODE_DOUBLE_H
+#define SYMENGINE_BYTECODE_DOUBLE_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <symengine/eval_double.h>
+#include <symengine/symengine_exception.h>
+#include <symengine/visitor.h>
+
+namespace SymEngine
+{
+
+/*
+   Operations of the bytecode evaluators below. Each instruction reads the
+   registers `a`, `b` and `c` and writes the register `dst`, except for the
+   jumps, whose targets are instruction indices.
+*/
+enum class BytecodeOp : unsigned char {
+    // r[dst] = r[a]
+    Mov,
+    // Arithmetic; MulAdd is r[dst] = r[a] + r[b] * r[c]
+    Add,
+    Mul,
+    MulAdd,
+    Pow,
+    Exp,
+    // Elementary functions
+    Sin,
+    Cos,
+    Tan,
+    Cot,
+    Csc,
+    Sec,
+    ASin,
+    ACos,
+    ASec,
+    ACsc,
+    ATan,
+    ACot,
+    Sinh,
+    Csch,
+    Cosh,
+    Sech,
+    Tanh,
+    Coth,
+    ASinh,
+    ACsch,
+    ACosh,
+    ATanh,
+    ACoth,
+    ASech,
+    Log,
+    Abs,
+    // Control flow for Piecewise: continue at instruction `a`, or at
+    // instruction `b` unless r[a] is 1
+    Jump,
+    JumpUnlessTrue,
+    // Operations that only exist for real numbers, see BytecodeRealOps
+    ATan2,
+    Gamma,
+    LogGamma,
+    Erf,
+    Erfc,
+    Equal,
+    Unequal,
+    LessThan,
+    StrictLessThan,
+    And,
+    Or,
+    Xor,
+    Not,
+    Max,
+    Min,
+    Sign,
+    Floor,
+    Ceiling,
+    Truncate,
+    // Lower and upper end of an Interval in Contains; `c` is 1 if it is open
+    IntervalStart,
+    IntervalEnd,
+};
+
+struct BytecodeInstruction {
+    BytecodeOp op;
+    unsigned dst, a, b, c;
+};
+
+//! Evaluation of the operations that only exist for real numbers
+template <typename T>
+struct BytecodeRealOps {
+    static void eval(const BytecodeInstruction &, T *)
+    {
+        throw SymEngineException("Operation not supported for this type");
+    }
+};
+
+template <>
+struct BytecodeRealOps<double> {
+    static void eval(const BytecodeInstruction &i, double *r)
+    {
+        const double inf = std::numeric_limits<double>::infinity();
+        switch (i.op) {
+            case BytecodeOp::ATan2:
+                r[i.dst] = std::atan2(r[i.a], r[i.b]);
+                break;
+            case BytecodeOp::Gamma:
+                r[i.dst] = std::tgamma(r[i.a]);
+                break;
+            case BytecodeOp::LogGamma:
+                r[i.dst] = std::lgamma(r[i.a]);
+                break;
+            case BytecodeOp::Erf:
+                r[i.dst] = std::erf(r[i.a]);
+                break;
+            case BytecodeOp::Erfc:
+                r[i.dst] = std::erfc(r[i.a]);
+                break;
+            case BytecodeOp::Equal:
+                r[i.dst] = (r[i.a] == r[i.b]);
+                break;
+            case BytecodeOp::Unequal:
+                r[i.dst] = (r[i.a] != r[i.b]);
+                break;
+            case BytecodeOp::LessThan:
+                r[i.dst] = (r[i.a] <= r[i.b]);
+                break;
+            case BytecodeOp::StrictLessThan:
+                r[i.dst] = (r[i.a] < r[i.b]);
+                break;
+            case BytecodeOp::And:
+                r[i.dst] = double(bool(r[i.a]) && bool(r[i.b]));
+                break;
+            case BytecodeOp::Or:
+                r[i.dst] = double(bool(r[i.a]) || bool(r[i.b]));
+                break;
+            case BytecodeOp::Xor:
+                r[i.dst] = double(bool(r[i.a]) != bool(r[i.b]));
+                break;
+            case BytecodeOp::Not:
+                r[i.dst] = double(not bool(r[i.a]));
+                break;
+            case BytecodeOp::Max:
+                r[i.dst] = std::max(r[i.a], r[i.b]);
+                break;
+            case BytecodeOp::Min:
+                r[i.dst] = std::min(r[i.a], r[i.b]);
+                break;
+            case BytecodeOp::Sign:
+                r[i.dst] = r[i.a] == 0.0 ? 0.0 : (r[i.a] < 0.0 ? -1.0 : 1.0);
+                break;
+            case BytecodeOp::Floor:
+                r[i.dst] = std::floor(r[i.a]);
+                break;
+            case BytecodeOp::Ceiling:
+                r[i.dst] = std::ceil(r[i.a]);
+                break;
+            case BytecodeOp::Truncate:
+                r[i.dst] = std::trunc(r[i.a]);
+                break;
+            case BytecodeOp::IntervalStart:
+                if (r[i.b] == -inf) {
+                    r[i.dst] = !std::isnan(r[i.a]);
+                } else {
+                    r[i.dst] = i.c ? (r[i.b] < r[i.a]) : (r[i.b] <= r[i.a]);
+                }
+                break;
+            case BytecodeOp::IntervalEnd:
+                if (r[i.b] == inf) {
+                    r[i.dst] = !std::isnan(r[i.a]);
+                } else {
+                    r[i.dst] = i.c ? (r[i.a] < r[i.b]) : (r[i.a] <= r[i.b]);
+                }
+                break;
+            default:
+                throw SymEngineException("Unknown bytecode operation");
+        }
+    }
+};
+
+/*
+   Evaluator that compiles expressions into a flat array of instructions
+   operating on an array of registers, and runs them with a single dispatch
+   loop. It is an alternative to LambdaDoubleVisitor, whose tree of closures
+   costs an indirect call per node, for when LLVM is not available.
+
+   Every distinct subexpression is computed into its own register exactly
+   once, so the program follows the expression DAG. The registers of the
+   inputs come first. Constants have registers of their own, which are only
+   filled in by init().
+*/
+template <typename T>
+class BytecodeDoubleVisitor : public BaseVisitor<BytecodeDoubleVisitor<T>>
+{
+protected:
+    std::vector<BytecodeInstruction> code_;
+    std::vector<T> registers_;
+    std::vector<unsigned> outputs_;
+    unsigned n_inputs_ = 0;
+
+    // Register of each subexpression compiled so far
+    umap_basic_uint registers_map_;
+    unsigned result_;
+
+    //! Allocates a register initialized to `value`
+    unsigned new_register(T value = T(0))
+    {
+        registers_.push_back(value);
+        return static_cast<unsigned>(registers_.size() - 1);
+    }
+
+    //! Emits an instruction writing to a new register, which is returned
+    unsigned emit(BytecodeOp op, unsigned a, unsigned b = 0, unsigned c = 0)
+    {
+        unsigned dst = new_register();
+        code_.push_back({op, dst, a, b, c});
+        return dst;
+    }
+
+    void unary(BytecodeOp op, const Basic &arg)
+    {
+        result_ = emit(op, apply(arg));
+    }
+
+    void binary(BytecodeOp op, const Basic &a, const Basic &b)
+    {
+        unsigned r = apply(a);
+        result_ = emit(op, r, apply(b));
+    }
+
+    //! Folds `args` with the binary operation `op`
+    void fold(BytecodeOp op, const vec_basic &args)
+    {
+        unsigned r = apply(*args[0]);
+        for (size_t i = 1; i < args.size(); ++i) {
+            r = emit(op, r, apply(*args[i]));
+        }
+        result_ = r;
+    }
+
+    //! Register of `base**exp`
+    unsigned apply_pow(const Basic &base, const Basic &exp)
+    {
+        unsigned b = apply(base);
+        if (eq(exp, *one)) {
+            return b;
+        }
+        if (is_a<Integer>(exp)
+            and down_cast<const Integer &>(exp).as_integer_class() == 2) {
+            return emit(BytecodeOp::Mul, b, b);
+        }
+        return emit(BytecodeOp::Pow, b, apply(exp));
+    }
+
+    void constant(T value)
+    {
+        result_ = new_register(value);
+    }
+
+public:
+    void init(const vec_basic &x, const Basic &b, bool cse = false)
+    {
+        vec_basic outputs = {b.rcp_from_this()};
+        init(x, outputs, cse);
+    }
+
+    void init(const vec_basic &inputs, const vec_basic &outputs,
+              bool cse = false)
+    {
+        code_.clear();
+        registers_.clear();
+        outputs_.clear();
+        registers_map_.clear();
+        n_inputs_ = static_cast<unsigned>(inputs.size());
+        for (auto &p : inputs) {
+            registers_map_.insert(std::make_pair(p, new_register()));
+        }
+        if (not cse) {
+            for (auto &p : outputs) {
+                outputs_.push_back(apply(*p));
+            }
+        } else {
+            vec_basic reduced_exprs;
+            vec_pair replacements;
+            SymEngine::cse(replacements, reduced_exprs, outputs);
+            for (auto &rep : replacements) {
+                registers_map_[rep.first] = apply(*(rep.second));
+            }
+            for (auto &p : reduced_exprs) {
+                outputs_.push_back(apply(*p));
+            }
+        }
+        // The inputs of the next init() may be symbols compiled here
+        registers_map_.clear();
+    }
+
+    //! Register holding the value of `b`, compiling it if necessary
+    unsigned apply(const Basic &b)
+    {
+        auto it = registers_map_.find(b.rcp_from_this());
+        if (it != registers_map_.end()) {
+            return it->second;
+        }
+        b.accept(*this);
+        registers_map_.insert(std::make_pair(b.rcp_from_this(), result_));
+        return result_;
+    }
+
+    T call(const std::vector<T> &vec)
+    {
+        T res;
+        call(&res, vec.data());
+        return res;
+    }
+
+    void call(T *outs, const T *inps)
+    {
+        T *r = registers_.data();
+        std::copy(inps, inps + n_inputs_, r);
+        const BytecodeInstruction *begin = code_.data();
+        const BytecodeInstruction *end = begin + code_.size();
+        for (const BytecodeInstruction *i = begin; i != end; ++i) {
+            switch (i->op) {
+                case BytecodeOp::Mov:
+                    r[i->dst] = r[i->a];
+                    break;
+                case BytecodeOp::Add:
+                    r[i->dst] = r[i->a] + r[i->b];
+                    break;
+                case BytecodeOp::Mul:
+                    r[i->dst] = r[i->a] * r[i->b];
+                    break;
+                case BytecodeOp::MulAdd:
+                    r[i->dst] = r[i->a] + r[i->b] * r[i->c];
+                    break;
+                case BytecodeOp::Pow:
+                    r[i->dst] = std::pow(r[i->a], r[i->b]);
+                    break;
+                case BytecodeOp::Exp:
+                    r[i->dst] = std::exp(r[i->a]);
+                    break;
+                case BytecodeOp::Sin:
+                    r[i->dst] = std::sin(r[i->a]);
+                    break;
+                case BytecodeOp::Cos:
+                    r[i->dst] = std::cos(r[i->a]);
+                    break;
+                case BytecodeOp::Tan:
+                    r[i->dst] = std::tan(r[i->a]);
+                    break;
+                case BytecodeOp::Cot:
+                    r[i->dst] = 1.0 / std::tan(r[i->a]);
+                    break;
+                case BytecodeOp::Csc:
+                    r[i->dst] = 1.0 / std::sin(r[i->a]);
+                    break;
+                case BytecodeOp::Sec:
+                    r[i->dst] = 1.0 / std::cos(r[i->a]);
+                    break;
+                case BytecodeOp::ASin:
+                    r[i->dst] = std::asin(r[i->a]);
+                    break;
+                case BytecodeOp::ACos:
+                    r[i->dst] = std::acos(r[i->a]);
+                    break;
+                case BytecodeOp::ASec:
+                    r[i->dst] = std::acos(1.0 / r[i->a]);
+                    break;
+                case BytecodeOp::ACsc:
+                    r[i->dst] = std::asin(1.0 / r[i->a]);
+                    break;
+                case BytecodeOp::ATan:
+                    r[i->dst] = std::atan(r[i->a]);
+                    break;
+                case BytecodeOp::ACot:
+                    r[i->dst] = std::atan(1.0 / r[i->a]);
+                    break;
+                case BytecodeOp::Sinh:
+                    r[i->dst] = std::sinh(r[i->a]);
+                    break;
+                case BytecodeOp::Csch:
+                    r[i->dst] = 1.0 / std::sinh(r[i->a]);
+                    break;
+                case BytecodeOp::Cosh:
+                    r[i->dst] = std::cosh(r[i->a]);
+                    break;
+                case BytecodeOp::Sech:
+                    r[i->dst] = 1.0 / std::cosh(r[i->a]);
+                    break;
+                case BytecodeOp::Tanh:
+                    r[i->dst] = std::tanh(r[i->a]);
+                    break;
+                case BytecodeOp::Coth:
+                    r[i->dst] = 1.0 / std::tanh(r[i->a]);
+                    break;
+                case BytecodeOp::ASinh:
+                    r[i->dst] = std::asinh(r[i->a]);
+                    break;
+                case BytecodeOp::ACsch:
+                    r[i->dst] = std::asinh(1.0 / r[i->a]);
+                    break;
+                case BytecodeOp::ACosh:
+                    r[i->dst] = std::acosh(r[i->a]);
+                    break;
+                case BytecodeOp::ATanh:
+                    r[i->dst] = std::atanh(r[i->a]);
+                    break;
+                case BytecodeOp::ACoth:
+                    r[i->dst] = std::atanh(1.0 / r[i->a]);
+                    break;
+                case BytecodeOp::ASech:
+                    r[i->dst] = std::acosh(1.0 / r[i->a]);
+                    break;
+                case BytecodeOp::Log:
+                    r[i->dst] = std::log(r[i->a]);
+                    break;
+                case BytecodeOp::Abs:
+                    r[i->dst] = std::abs(r[i->a]);
+                    break;
+                case BytecodeOp::Jump:
+                    // The loop increments `i` again
+                    i = begin + i->a - 1;
+                    break;
+                case BytecodeOp::JumpUnlessTrue:
+                    if (r[i->a] != T(1.0)) {
+                        i = begin + i->b - 1;
+                    }
+                    break;
+                default:
+                    BytecodeRealOps<T>::eval(*i, r);
+            }
+        }
+        for (size_t i = 0; i < outputs_.size(); ++i) {
+            outs[i] = r[outputs_[i]];
+        }
+    }
+
+    void bvisit(const Symbol &x)
+    {
+        throw SymEngineException("Symbol not in the symbols vector.");
+    };
+
+    void bvisit(const Integer &x)
+    {
+        constant(mp_get_d(x.as_integer_class()));
+    }
+
+    void bvisit(const Rational &x)
+    {
+        constant(mp_get_d(x.as_rational_class()));
+    }
+
+    void bvisit(const RealDouble &x)
+    {
+        constant(x.i);
+    }
+
+#ifdef HAVE_SYMENGINE_MPFR
+    void bvisit(const RealMPFR &x)
+    {
+        constant(mpfr_get_d(x.i.get_mpfr_t(), MPFR_RNDN));
+    }
+#endif
+
+    void bvisit(const Add &x)
+    {
+        unsigned r = apply(*x.get_coef());
+        for (const auto &p : x.get_dict()) {
+            unsigned t = apply(*(p.first));
+            r = emit(BytecodeOp::MulAdd, r, t, apply(*(p.second)));
+        }
+        result_ = r;
+    }
+
+    void bvisit(const Mul &x)
+    {
+        unsigned r = apply(*x.get_coef());
+        for (const auto &p : x.get_dict()) {
+            r = emit(BytecodeOp::Mul, r, apply_pow(*(p.first), *(p.second)));
+        }
+        result_ = r;
+    }
+
+    void bvisit(const Pow &x)
+    {
+        if (eq(*(x.get_base()), *E)) {
+            unary(BytecodeOp::Exp, *(x.get_exp()));
+        } else {
+            result_ = apply_pow(*(x.get_base()), *(x.get_exp()));
+        }
+    }
+
+    void bvisit(const Sin &x)
+    {
+        unary(BytecodeOp::Sin, *(x.get_arg()));
+    }
+
+    void bvisit(const Cos &x)
+    {
+        unary(BytecodeOp::Cos, *(x.get_arg()));
+    }
+
+    void bvisit(const Tan &x)
+    {
+        unary(BytecodeOp::Tan, *(x.get_arg()));
+    }
+
+    void bvisit(const Log &x)
+    {
+        unary(BytecodeOp::Log, *(x.get_arg()));
+    };
+
+    void bvisit(const Cot &x)
+    {
+        unary(BytecodeOp::Cot, *(x.get_arg()));
+    };
+
+    void bvisit(const Csc &x)
+    {
+        unary(BytecodeOp::Csc, *(x.get_arg()));
+    };
+
+    void bvisit(const Sec &x)
+    {
+        unary(BytecodeOp::Sec, *(x.get_arg()));
+    };
+
+    void bvisit(const ASin &x)
+    {
+        unary(BytecodeOp::ASin, *(x.get_arg()));
+    };
+
+    void bvisit(const ACos &x)
+    {
+        unary(BytecodeOp::ACos, *(x.get_arg()));
+    };
+
+    void bvisit(const ASec &x)
+    {
+        unary(BytecodeOp::ASec, *(x.get_arg()));
+    };
+
+    void bvisit(const ACsc &x)
+    {
+        unary(BytecodeOp::ACsc, *(x.get_arg()));
+    };
+
+    void bvisit(const ATan &x)
+    {
+        unary(BytecodeOp::ATan, *(x.get_arg()));
+    };
+
+    void bvisit(const ACot &x)
+    {
+        unary(BytecodeOp::ACot, *(x.get_arg()));
+    };
+
+    void bvisit(const Sinh &x)
+    {
+        unary(BytecodeOp::Sinh, *(x.get_arg()));
+    };
+
+    void bvisit(const Csch &x)
+    {
+        unary(BytecodeOp::Csch, *(x.get_arg()));
+    };
+
+    void bvisit(const Cosh &x)
+    {
+        unary(BytecodeOp::Cosh, *(x.get_arg()));
+    };
+
+    void bvisit(const Sech &x)
+    {
+        unary(BytecodeOp::Sech, *(x.get_arg()));
+    };
+
+    void bvisit(const Tanh &x)
+    {
+        unary(BytecodeOp::Tanh, *(x.get_arg()));
+    };
+
+    void bvisit(const Coth &x)
+    {
+        unary(BytecodeOp::Coth, *(x.get_arg()));
+    };
+
+    void bvisit(const ASinh &x)
+    {
+        unary(BytecodeOp::ASinh, *(x.get_arg()));
+    };
+
+    void bvisit(const ACsch &x)
+    {
+        unary(BytecodeOp::ACsch, *(x.get_arg()));
+    };
+
+    void bvisit(const ACosh &x)
+    {
+        unary(BytecodeOp::ACosh, *(x.get_arg()));
+    };
+
+    void bvisit(const ATanh &x)
+    {
+        unary(BytecodeOp::ATanh, *(x.get_arg()));
+    };
+
+    void bvisit(const ACoth &x)
+    {
+        unary(BytecodeOp::ACoth, *(x.get_arg()));
+    };
+
+    void bvisit(const ASech &x)
+    {
+        unary(BytecodeOp::ASech, *(x.get_arg()));
+    };
+
+    void bvisit(const Constant &x)
+    {
+        constant(eval_double(x));
+    };
+
+    void bvisit(const Abs &x)
+    {
+        unary(BytecodeOp::Abs, *(x.get_arg()));
+    };
+
+    void bvisit(const Basic &)
+    {
+        throw NotImplementedError("Not Implemented");
+    };
+
+    void bvisit(const UnevaluatedExpr &x)
+    {
+        result_ = apply(*x.get_arg());
+    };
+};
+
+class BytecodeRealDoubleVisitor
+    : public BaseVisitor<BytecodeRealDoubleVisitor,
+                         BytecodeDoubleVisitor<double>>
+{
+public:
+    // Supports the same classes as LambdaRealDoubleVisitor
+
+    using BytecodeDoubleVisitor::bvisit;
+
+    void bvisit(const ATan2 &x)
+    {
+        binary(BytecodeOp::ATan2, *(x.get_num()), *(x.get_den()));
+    };
+
+    void bvisit(const Gamma &x)
+    {
+        unary(BytecodeOp::Gamma, *(x.get_args()[0]));
+    };
+
+    void bvisit(const LogGamma &x)
+    {
+        unary(BytecodeOp::LogGamma, *(x.get_args()[0]));
+    };
+
+    void bvisit(const Erf &x)
+    {
+        unary(BytecodeOp::Erf, *(x.get_args()[0]));
+    }
+
+    void bvisit(const Erfc &x)
+    {
+        unary(BytecodeOp::Erfc, *(x.get_args()[0]));
+    }
+
+    void bvisit(const Equality &x)
+    {
+        binary(BytecodeOp::Equal, *(x.get_arg1()), *(x.get_arg2()));
+    }
+
+    void bvisit(const Unequality &x)
+    {
+        binary(BytecodeOp::Unequal, *(x.get_arg1()), *(x.get_arg2()));
+    }
+
+    void bvisit(const LessThan &x)
+    {
+        binary(BytecodeOp::LessThan, *(x.get_arg1()), *(x.get_arg2()));
+    }
+
+    void bvisit(const StrictLessThan &x)
+    {
+        binary(BytecodeOp::StrictLessThan, *(x.get_arg1()), *(x.get_arg2()));
+    }
+
+    void bvisit(const And &x)
+    {
+        fold(BytecodeOp::And, x.get_args());
+    }
+
+    void bvisit(const Or &x)
+    {
+        fold(BytecodeOp::Or, x.get_args());
+    }
+
+    void bvisit(const Xor &x)
+    {
+        fold(BytecodeOp::Xor, x.get_args());
+    }
+
+    void bvisit(const Not &x)
+    {
+        unary(BytecodeOp::Not, *(x.get_arg()));
+    }
+
+    void bvisit(const Max &x)
+    {
+        fold(BytecodeOp::Max, x.get_args());
+    };
+
+    void bvisit(const Min &x)
+    {
+        fold(BytecodeOp::Min, x.get_args());
+    };
+
+    void bvisit(const Sign &x)
+    {
+        unary(BytecodeOp::Sign, *(x.get_arg()));
+    };
+
+    void bvisit(const Floor &x)
+    {
+        unary(BytecodeOp::Floor, *(x.get_arg()));
+    };
+
+    void bvisit(const Ceiling &x)
+    {
+        unary(BytecodeOp::Ceiling, *(x.get_arg()));
+    };
+
+    void bvisit(const Truncate &x)
+    {
+        unary(BytecodeOp::Truncate, *(x.get_arg()));
+    };
+
+    void bvisit(const Infty &x)
+    {
+        if (x.is_negative_infinity()) {
+            constant(-std::numeric_limits<double>::infinity());
+        } else if (x.is_positive_infinity()) {
+            constant(std::numeric_limits<double>::infinity());
+        } else {
+            throw SymEngineException(
+                "BytecodeDouble can only represent real valued infinity");
+        }
+    }
+
+    void bvisit(const NaN &nan)
+    {
+        constant(std::numeric_limits<double>::signaling_NaN());
+    }
+
+    void bvisit(const Contains &cts)
+    {
+        const auto set = cts.get_set();
+        if (is_a<Interval>(*set)) {
+            const auto &interv = down_cast<const Interval &>(*set);
+            unsigned expr = apply(*cts.get_expr());
+            unsigned start = apply(*interv.get_start());
+            unsigned end = apply(*interv.get_end());
+            unsigned left_ok = emit(BytecodeOp::IntervalStart, expr, start,
+                                    interv.get_left_open());
+            unsigned right_ok = emit(BytecodeOp::IntervalEnd, expr, end,
+                                     interv.get_right_open());
+            result_ = emit(BytecodeOp::And, left_ok, right_ok);
+        } else {
+            throw SymEngineException("BytecodeDoubleVisitor: only "
+                                     "``Interval`` implemented for "
+                                     "``Contains``.");
+        }
+    }
+
+    void bvisit(const BooleanAtom &ba)
+    {
+        constant(ba.get_val() ? 1.0 : 0.0);
+    }
+
+    void bvisit(const Piecewise &pw)
+    {
+        SYMENGINE_ASSERT_MSG(
+            eq(*pw.get_vec().back().second, *boolTrue),
+            "BytecodeDouble requires a (Expr, True) at the end of Piecewise");
+
+        unsigned dst = new_register();
+        std::vector<size_t> jumps_to_end;
+        for (const auto &expr_pred : pw.get_vec()) {
+            // Registers computed in one branch are not available in the
+            // others, or after the Piecewise
+            umap_basic_uint saved = registers_map_;
+            unsigned pred = apply(*expr_pred.second);
+            size_t jump_to_next = code_.size();
+            code_.push_back({BytecodeOp::JumpUnlessTrue, 0, pred, 0, 0});
+            unsigned value = apply(*expr_pred.first);
+            code_.push_back({BytecodeOp::Mov, dst, value, 0, 0});
+            jumps_to_end.push_back(code_.size());
+            code_.push_back({BytecodeOp::Jump, 0, 0, 0, 0});
+            code_[jump_to_next].b = static_cast<unsigned>(code_.size());
+            registers_map_ = std::move(saved);
+        }
+        for (size_t j : jumps_to_end) {
+            code_[j].a = static_cast<unsigned>(code_.size());
+        }
+        result_ = dst;
+    }
+};
+
+class BytecodeComplexDoubleVisitor
+    : public BaseVisitor<BytecodeComplexDoubleVisitor,
+                         BytecodeDoubleVisitor<std::complex<double>>>
+{
+public:
+    // Supports the same classes as LambdaComplexDoubleVisitor
+
+    using BytecodeDoubleVisitor::bvisit;
+
+    void bvisit(const Complex &x)
+    {
+        constant(std::complex<double>(mp_get_d(x.real_),
+                                      mp_get_d(x.imaginary_)));
+    };
+
+    void bvisit(const ComplexDouble &x)
+    {
+        constant(x.i);
+    };
+#ifdef HAVE_SYMENGINE_MPC
+    void bvisit(const ComplexMPC &x)
+    {
+        mpfr_class t(x.get_prec());
+        double real, imag;
+        mpc_real(t.get_mpfr_t(), x.as_mpc().get_mpc_t(), MPFR_RNDN);
+        real = mpfr_get_d(t.get_mpfr_t(), MPFR_RNDN);
+        mpc_imag(t.get_mpfr_t(), x.as_mpc().get_mpc_t(), MPFR_RNDN);
+        imag = mpfr_get_d(t.get_mpfr_t(), MPFR_RNDN);
+        constant(std::complex<double>(real, imag));
+    }
+#endif
+};
+} // namespace SymEngine
+#endif // SYMENGINE_BYTECODE_DOUBLE_H
@@ -78,50 +78,37 @@ public:
     get_common_arg_candidates(std::set<unsigned> &argset, unsigned min_func_i)
     {
         std::map<unsigned, unsigned> count_map;
-        std::vector<std::set<unsigned>> funcsets;
+        std::vector<const std::set<unsigned> *> funcsets;
         for (unsigned arg : argset) {
-            funcsets.push_back(arg_to_funcset[arg]);
+            funcsets.push_back(&arg_to_funcset[arg]);
+        }
+        if (funcsets.empty()) {
+            return count_map;
         }
         // Sorted by size to make best use of the performance hack below.
         std::sort(funcsets.begin(), funcsets.end(),
-                  [](const std::set<unsigned> &a, const std::set<unsigned> &b) {
-                      return a.size() < b.size();
+                  [](const std::set<unsigned> *a, const std::set<unsigned> *b) {
+                      return a->size() < b->size();
                   });
 
-        for (unsigned i = 0; i < funcsets.size(); i++) {
-            auto &funcset = funcsets[i];
-            for (unsigned func_i : funcset) {
+        // A function with at least two arguments in common with `argset` is
+        // in at least one of the sets apart from the largest one, so the
+        // largest set, which often holds nearly every function, is only used
+        // for lookups.
+        for (unsigned i = 0; i + 1 < funcsets.size(); i++) {
+            for (unsigned func_i : *funcsets[i]) {
                 if (func_i >= min_func_i) {
                     count_map[func_i] += 1;
                 }
             }
         }
-
-        /*auto &largest_funcset = funcsets[funcsets.size() - 1];
-
-        // We pick the smaller of the two containers to iterate over to
-        // reduce the number of items we have to look at.
-
-        if (largest_funcset.size() < count_map.size()) {
-            for (unsigned func_i : largest_funcset) {
-                if (count_map[func_i] < 1) {
-                    continue;
-                }
-                if (count_map.find(func_i) != count_map.end()) {
-                    count_map[func_i] += 1;
-                }
+        const std::set<unsigned> &largest_funcset = *funcsets.back();
+        for (auto &count_map_pair : count_map) {
+            if (largest_funcset.find(count_map_pair.first)
+                != largest_funcset.end()) {
+                count_map_pair.second += 1;
             }
-        } else {
-            for (auto &count_map_pair : count_map) {
-                unsigned func_i = count_map_pair.first;
-                if (count_map[func_i] < 1) {
-                    continue;
-                }
-                if (largest_funcset.find(func_i) != largest_funcset.end()) {
-                    count_map[func_i] += 1;
-                }
-            }
-        }*/
+        }
         auto iter = count_map.begin();
         for (; iter != count_map.end();) {
             if (iter->second >= 2) {
@@ -143,14 +130,16 @@ public:
             indices.push_back(f);
         }
         std::sort(std::begin(indices), std::end(indices));
-        std::vector<unsigned> intersect_result;
+        // Look the candidates up instead of merging, as the sets of the
+        // arguments can be much larger than the candidates
         for (const auto &arg : argset) {
-            std::set_intersection(indices.begin(), indices.end(),
-                                  arg_to_funcset[arg].begin(),
-                                  arg_to_funcset[arg].end(),
-                                  std::back_inserter(intersect_result));
-            intersect_result.swap(indices);
-            intersect_result.clear();
+            const std::set<unsigned> &funcset = arg_to_funcset[arg];
+            indices.erase(std::remove_if(indices.begin(), indices.end(),
+                                         [&](unsigned f) {
+                                             return funcset.find(f)
+                                                    == funcset.end();
+                                         }),
+                          indices.end());
         }
         return indices;
     }
@@ -299,7 +288,7 @@ void match_common_args(const std::string &func_class, const vec_basic &funcs_,
                 changed.insert(k);
             }
         }
-        if (std::find(changed.begin(), changed.end(), i) != changed.end()) {
+        if (changed.find(i) != changed.end()) {
             opt_subs[funcs[i].first] = function_symbol(
                 func_class, arg_tracker.get_args_in_value_order(
                                 arg_tracker.func_to_argset[i]));
@@ -314,7 +303,7 @@ public:
     umap_basic_basic &opt_subs;
     set_basic adds;
     set_basic muls;
-    set_basic seen_subexp;
+    uset_basic seen_subexp;
     OptsCSEVisitor(umap_basic_basic &opt_subs_) : opt_subs(opt_subs_) {}
     bool is_seen(const Basic &expr)
     {
@@ -422,8 +411,8 @@ class RebuildVisitor : public BaseVisitor<RebuildVisitor, TransformVisitor>
 private:
     umap_basic_basic &subs;
     umap_basic_basic &opt_subs;
-    set_basic &to_eliminate;
-    set_basic &excluded_symbols;
+    uset_basic &to_eliminate;
+    uset_basic &excluded_symbols;
     vec_pair &replacements;
     unsigned next_symbol_index = 0;
 
@@ -431,7 +420,7 @@ public:
     using TransformVisitor::bvisit;
     using TransformVisitor::result_;
     RebuildVisitor(umap_basic_basic &subs_, umap_basic_basic &opt_subs_,
-                   set_basic &to_eliminate_, set_basic &excluded_symbols_,
+                   uset_basic &to_eliminate_, uset_basic &excluded_symbols_,
                    vec_pair &replacements_)
         : subs(subs_), opt_subs(opt_subs_), to_eliminate(to_eliminate_),
           excluded_symbols(excluded_symbols_), replacements(replacements_)
@@ -495,9 +484,9 @@ public:
 void tree_cse(vec_pair &replacements, vec_basic &reduced_exprs,
               const vec_basic &exprs, umap_basic_basic &opt_subs)
 {
-    set_basic to_eliminate;
-    set_basic seen_subexp;
-    set_basic excluded_symbols;
+    uset_basic to_eliminate;
+    uset_basic seen_subexp;
+    uset_basic excluded_symbols;
 
     std::function<void(RCP<const Basic> & expr)> find_repeated;
     find_repeated = [&](RCP<const Basic> expr) -> void {
@@ -1,8 +1,14 @@
+#include <algorithm>
+#include <cmath>
 #include <symengine/matrix.h>
 #include <symengine/number.h>
 #include <symengine/add.h>
+#include <symengine/derivative.h>
 #include <symengine/functions.h>
+#include <symengine/ntheory.h>
 #include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
 #include <symengine/subs.h>
 #include <symengine/symengine_exception.h>
 #include <symengine/polys/uexprpoly.h>
@@ -329,8 +335,19 @@ tribool DenseMatrix::is_negative_definite() const
     return res.is_positive_definite();
 }
 
+// Integer and rational matrices of at least this size are handled with the
+// multi-modular algorithms by `det` and `LU_solve`
+static const unsigned modular_threshold = 16;
+
+static bool try_det_modular(const DenseMatrix &A, RCP<const Basic> &det);
+static bool try_modular_solve(const DenseMatrix &A, const DenseMatrix &b,
+                              DenseMatrix &x);
+
 RCP<const Basic> DenseMatrix::det() const
 {
+    RCP<const Basic> d;
+    if (row_ >= modular_threshold and try_det_modular(*this, d))
+        return d;
     return det_bareis(*this);
 }
 
@@ -464,6 +481,8 @@ void DenseMatrix::LU_solve(const MatrixBase &b, MatrixBase &x) const
     if (is_a<DenseMatrix>(b) and is_a<DenseMatrix>(x)) {
         const DenseMatrix &b_ = down_cast<const DenseMatrix &>(b);
         DenseMatrix &x_ = down_cast<DenseMatrix &>(x);
+        if (row_ >= modular_threshold and try_modular_solve(*this, b_, x_))
+            return;
         SymEngine::LU_solve(*this, b_, x_);
     }
 }
@@ -510,6 +529,9 @@ void DenseMatrix::cholesky(MatrixBase &L) const
 
 // ---------------------------- Jacobian -------------------------------------//
 
+// Each column is differentiated with a single DiffVisitor, so that the
+// derivatives of subexpressions shared between the entries of `A` are only
+// computed once per symbol.
 void jacobian(const DenseMatrix &A, const DenseMatrix &x, DenseMatrix &result,
               bool diff_cache)
 {
@@ -518,16 +540,14 @@ void jacobian(const DenseMatrix &A, const DenseMatrix &x, DenseMatrix &result,
     SYMENGINE_ASSERT(A.row_ == result.nrows() and x.row_ == result.ncols());
     bool error = false;
 #pragma omp parallel for
-    for (unsigned i = 0; i < result.row_; i++) {
-        for (unsigned j = 0; j < result.col_; j++) {
-            if (is_a<Symbol>(*(x.m_[j]))) {
-                const RCP<const Symbol> x_
-                    = rcp_static_cast<const Symbol>(x.m_[j]);
-                result.m_[i * result.col_ + j] = A.m_[i]->diff(x_, diff_cache);
-            } else {
-                error = true;
-                break;
-            }
+    for (unsigned j = 0; j < result.col_; j++) {
+        if (not is_a<Symbol>(*(x.m_[j]))) {
+            error = true;
+            continue;
+        }
+        DiffVisitor v(rcp_static_cast<const Symbol>(x.m_[j]), diff_cache);
+        for (unsigned i = 0; i < result.row_; i++) {
+            result.m_[i * result.col_ + j] = v.apply(A.m_[i]);
         }
     }
     if (error) {
@@ -544,18 +564,20 @@ void sjacobian(const DenseMatrix &A, const DenseMatrix &x, DenseMatrix &result,
     SYMENGINE_ASSERT(x.col_ == 1);
     SYMENGINE_ASSERT(A.row_ == result.nrows() and x.row_ == result.ncols());
 #pragma omp parallel for
-    for (unsigned i = 0; i < result.row_; i++) {
-        for (unsigned j = 0; j < result.col_; j++) {
-            if (is_a<Symbol>(*(x.m_[j]))) {
-                const RCP<const Symbol> x_
-                    = rcp_static_cast<const Symbol>(x.m_[j]);
-                result.m_[i * result.col_ + j] = A.m_[i]->diff(x_, diff_cache);
-            } else {
-                // TODO: Use a dummy symbol
-                const RCP<const Symbol> x_ = symbol("x_");
-                result.m_[i * result.col_ + j] = ssubs(
-                    ssubs(A.m_[i], {{x.m_[j], x_}})->diff(x_, diff_cache),
-                    {{x_, x.m_[j]}});
+    for (unsigned j = 0; j < result.col_; j++) {
+        if (is_a<Symbol>(*(x.m_[j]))) {
+            DiffVisitor v(rcp_static_cast<const Symbol>(x.m_[j]), diff_cache);
+            for (unsigned i = 0; i < result.row_; i++) {
+                result.m_[i * result.col_ + j] = v.apply(A.m_[i]);
+            }
+        } else {
+            // TODO: Use a dummy symbol
+            const RCP<const Symbol> x_ = symbol("x_");
+            DiffVisitor v(x_, diff_cache);
+            for (unsigned i = 0; i < result.row_; i++) {
+                result.m_[i * result.col_ + j]
+                    = ssubs(v.apply(ssubs(A.m_[i], {{x.m_[j], x_}})),
+                            {{x_, x.m_[j]}});
             }
         }
     }
@@ -563,15 +585,20 @@ void sjacobian(const DenseMatrix &A, const DenseMatrix &x, DenseMatrix &result,
 
 // ---------------------------- Diff -------------------------------------//
 
+// Every thread keeps one DiffVisitor for all the entries it differentiates
 void diff(const DenseMatrix &A, const RCP<const Symbol> &x, DenseMatrix &result,
           bool diff_cache)
 {
     SYMENGINE_ASSERT(A.row_ == result.nrows() and A.col_ == result.ncols());
-#pragma omp parallel for
-    for (unsigned i = 0; i < result.row_; i++) {
-        for (unsigned j = 0; j < result.col_; j++) {
-            result.m_[i * result.col_ + j]
-                = A.m_[i * result.col_ + j]->diff(x, diff_cache);
+#pragma omp parallel
+    {
+        DiffVisitor v(x, diff_cache);
+#pragma omp for
+        for (unsigned i = 0; i < result.row_; i++) {
+            for (unsigned j = 0; j < result.col_; j++) {
+                result.m_[i * result.col_ + j]
+                    = v.apply(A.m_[i * result.col_ + j]);
+            }
         }
     }
 }
@@ -580,23 +607,346 @@ void sdiff(const DenseMatrix &A, const RCP<const Basic> &x, DenseMatrix &result,
            bool diff_cache)
 {
     SYMENGINE_ASSERT(A.row_ == result.nrows() and A.col_ == result.ncols());
-#pragma omp parallel for
-    for (unsigned i = 0; i < result.row_; i++) {
-        for (unsigned j = 0; j < result.col_; j++) {
-            if (is_a<Symbol>(*x)) {
-                const RCP<const Symbol> x_ = rcp_static_cast<const Symbol>(x);
-                result.m_[i * result.col_ + j]
-                    = A.m_[i * result.col_ + j]->diff(x_, diff_cache);
-            } else {
-                // TODO: Use a dummy symbol
-                const RCP<const Symbol> x_ = symbol("_x");
-                result.m_[i * result.col_ + j]
-                    = ssubs(ssubs(A.m_[i * result.col_ + j], {{x, x_}})
-                                ->diff(x_, diff_cache),
-                            {{x_, x}});
+    if (is_a<Symbol>(*x)) {
+        diff(A, rcp_static_cast<const Symbol>(x), result, diff_cache);
+        return;
+    }
+#pragma omp parallel
+    {
+        // TODO: Use a dummy symbol
+        const RCP<const Symbol> x_ = symbol("_x");
+        DiffVisitor v(x_, diff_cache);
+#pragma omp for
+        for (unsigned i = 0; i < result.row_; i++) {
+            for (unsigned j = 0; j < result.col_; j++) {
+                const RCP<const Basic> e
+                    = ssubs(A.m_[i * result.col_ + j], {{x, x_}});
+                result.m_[i * result.col_ + j] = ssubs(v.apply(e), {{x_, x}});
+            }
+        }
+    }
+}
+
+// --------------------------- Numeric Fast Paths ----------------------------//
+// Matrices whose entries are all Integers, all Integers and Rationals, or all
+// RealDoubles are converted to contiguous buffers of `integer_class`,
+// `rational_class` or `double` so that the kernels below avoid boxing every
+// intermediate result in a Basic.
+
+static bool numeric_value(const Basic &b, integer_class &v)
+{
+    if (is_a<Integer>(b)) {
+        v = down_cast<const Integer &>(b).as_integer_class();
+        return true;
+    }
+    return false;
+}
+
+static bool numeric_value(const Basic &b, rational_class &v)
+{
+    if (is_a<Integer>(b)) {
+        v = rational_class(down_cast<const Integer &>(b).as_integer_class());
+        return true;
+    } else if (is_a<Rational>(b)) {
+        v = down_cast<const Rational &>(b).as_rational_class();
+        return true;
+    }
+    return false;
+}
+
+static bool numeric_value(const Basic &b, double &v)
+{
+    if (is_a<RealDouble>(b)) {
+        v = down_cast<const RealDouble &>(b).as_double();
+        return true;
+    }
+    return false;
+}
+
+static RCP<const Basic> numeric_to_basic(const integer_class &v)
+{
+    return integer(v);
+}
+
+static RCP<const Basic> numeric_to_basic(const rational_class &v)
+{
+    return Rational::from_mpq(v);
+}
+
+static RCP<const Basic> numeric_to_basic(double v)
+{
+    return real_double(v);
+}
+
+static bool numeric_is_zero(const integer_class &v)
+{
+    return mp_sign(v) == 0;
+}
+
+static bool numeric_is_zero(const rational_class &v)
+{
+    return mp_sign(v) == 0;
+}
+
+static bool numeric_is_zero(double v)
+{
+    return v == 0.0;
+}
+
+// Row to pivot on in column `k`, or `n` if the column is zero from row `k`
+// downwards. Exact entries take the first nonzero one, doubles the largest.
+template <typename T>
+static unsigned numeric_pivot(const std::vector<T> &a, unsigned n, unsigned k)
+{
+    for (unsigned i = k; i < n; i++) {
+        if (not numeric_is_zero(a[i * n + k])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+static unsigned numeric_pivot(const std::vector<double> &a, unsigned n,
+                              unsigned k)
+{
+    unsigned p = n;
+    double max = 0.0;
+    for (unsigned i = k; i < n; i++) {
+        if (std::abs(a[i * n + k]) > max) {
+            max = std::abs(a[i * n + k]);
+            p = i;
+        }
+    }
+    return p;
+}
+
+template <typename T>
+static bool numeric_buffer(const vec_basic &m, std::vector<T> &v)
+{
+    v.resize(m.size());
+    for (size_t i = 0; i < m.size(); i++) {
+        if (m[i].is_null() or not numeric_value(*m[i], v[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+static void basic_buffer(const std::vector<T> &v, vec_basic &m)
+{
+    m.resize(v.size());
+    for (size_t i = 0; i < v.size(); i++) {
+        m[i] = numeric_to_basic(v[i]);
+    }
+}
+
+// C = A B for a `row x inner` matrix A and an `inner x col` matrix B. All
+// three loops are blocked, so that a block of B is reused for a block of rows
+// of A, and the innermost loop traverses B and C row-wise.
+template <typename T>
+static void numeric_mul(const std::vector<T> &a, const std::vector<T> &b,
+                        std::vector<T> &c, unsigned row, unsigned inner,
+                        unsigned col)
+{
+    const unsigned block = 64;
+    c.assign(static_cast<size_t>(row) * col, T(0));
+#pragma omp parallel for if (static_cast<size_t>(row) * inner * col > 1000000)
+    for (unsigned ii = 0; ii < row; ii += block) {
+        const unsigned iend = std::min(ii + block, row);
+        for (unsigned kk = 0; kk < inner; kk += block) {
+            const unsigned kend = std::min(kk + block, inner);
+            for (unsigned jj = 0; jj < col; jj += block) {
+                const unsigned jend = std::min(jj + block, col);
+                for (unsigned i = ii; i < iend; i++) {
+                    for (unsigned k = kk; k < kend; k++) {
+                        const T &aik = a[i * inner + k];
+                        if (numeric_is_zero(aik)) {
+                            continue;
+                        }
+                        for (unsigned j = jj; j < jend; j++) {
+                            c[i * col + j] += aik * b[k * col + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Determinant of the `n x n` matrix `a` by Gaussian elimination
+template <typename T>
+static T numeric_det(std::vector<T> a, unsigned n)
+{
+    T det(1);
+    for (unsigned k = 0; k < n; k++) {
+        unsigned p = numeric_pivot(a, n, k);
+        if (p == n) {
+            return T(0);
+        }
+        if (p != k) {
+            for (unsigned j = k; j < n; j++) {
+                std::swap(a[p * n + j], a[k * n + j]);
+            }
+            det = -det;
+        }
+        det *= a[k * n + k];
+#pragma omp parallel for if ((n - k) * (n - k) > 100000)
+        for (unsigned i = k + 1; i < n; i++) {
+            if (numeric_is_zero(a[i * n + k])) {
+                continue;
+            }
+            const T factor = a[i * n + k] / a[k * n + k];
+            for (unsigned j = k + 1; j < n; j++) {
+                a[i * n + j] -= factor * a[k * n + j];
+            }
+        }
+    }
+    return det;
+}
+
+// Determinant of the integer `n x n` matrix `a` by fraction-free (Bareiss)
+// elimination: after step `k` the entries are minors of order `k + 2`, and the
+// division by the previous pivot is exact.
+static integer_class numeric_det(std::vector<integer_class> a, unsigned n)
+{
+    integer_class prev(1);
+    bool negate = false;
+    for (unsigned k = 0; k < n; k++) {
+        unsigned p = numeric_pivot(a, n, k);
+        if (p == n) {
+            return integer_class(0);
+        }
+        if (p != k) {
+            for (unsigned j = k; j < n; j++) {
+                std::swap(a[p * n + j], a[k * n + j]);
+            }
+            negate = not negate;
+        }
+#pragma omp parallel for if ((n - k) * (n - k) > 10000)
+        for (unsigned i = k + 1; i < n; i++) {
+            integer_class t;
+            for (unsigned j = k + 1; j < n; j++) {
+                t = a[k * n + k] * a[i * n + j] - a[i * n + k] * a[k * n + j];
+                mp_divexact(a[i * n + j], t, prev);
+            }
+        }
+        prev = a[k * n + k];
+    }
+    return negate ? integer_class(-prev) : prev;
+}
+
+// Doolittle LU factorization without pivoting, in place. `L` is stored below
+// the diagonal of `a` and `U` on and above it. Returns false if a zero pivot
+// is met.
+template <typename T>
+static bool numeric_LU(std::vector<T> &a, unsigned n)
+{
+    for (unsigned k = 0; k < n; k++) {
+        if (numeric_is_zero(a[k * n + k])) {
+            return false;
+        }
+#pragma omp parallel for if ((n - k) * (n - k) > 100000)
+        for (unsigned i = k + 1; i < n; i++) {
+            a[i * n + k] /= a[k * n + k];
+            const T &factor = a[i * n + k];
+            if (numeric_is_zero(factor)) {
+                continue;
+            }
+            for (unsigned j = k + 1; j < n; j++) {
+                a[i * n + j] -= factor * a[k * n + j];
             }
         }
     }
+    return true;
+}
+
+// Solves `a x = b` in place for the `n x n` matrix `a` and the `n x bcol`
+// matrix `b` by Gaussian elimination with row pivoting. Returns false if `a`
+// is singular.
+template <typename T>
+static bool numeric_solve(std::vector<T> a, std::vector<T> &b, unsigned n,
+                          unsigned bcol)
+{
+    for (unsigned k = 0; k < n; k++) {
+        unsigned p = numeric_pivot(a, n, k);
+        if (p == n) {
+            return false;
+        }
+        if (p != k) {
+            for (unsigned j = k; j < n; j++) {
+                std::swap(a[p * n + j], a[k * n + j]);
+            }
+            for (unsigned j = 0; j < bcol; j++) {
+                std::swap(b[p * bcol + j], b[k * bcol + j]);
+            }
+        }
+#pragma omp parallel for if ((n - k) * (n + bcol) > 100000)
+        for (unsigned i = k + 1; i < n; i++) {
+            if (numeric_is_zero(a[i * n + k])) {
+                continue;
+            }
+            const T factor = a[i * n + k] / a[k * n + k];
+            for (unsigned j = k + 1; j < n; j++) {
+                a[i * n + j] -= factor * a[k * n + j];
+            }
+            for (unsigned j = 0; j < bcol; j++) {
+                b[i * bcol + j] -= factor * b[k * bcol + j];
+            }
+        }
+    }
+    for (unsigned k = n; k-- > 0;) {
+        for (unsigned j = 0; j < bcol; j++) {
+            for (unsigned i = k + 1; i < n; i++) {
+                b[k * bcol + j] -= a[k * n + i] * b[i * bcol + j];
+            }
+            b[k * bcol + j] /= a[k * n + k];
+        }
+    }
+    return true;
+}
+
+template <typename T>
+static bool numeric_mul_dense_dense(const vec_basic &A, const vec_basic &B,
+                                    vec_basic &C, unsigned row, unsigned inner,
+                                    unsigned col)
+{
+    std::vector<T> a, b, c;
+    if (not numeric_buffer(A, a) or not numeric_buffer(B, b)) {
+        return false;
+    }
+    numeric_mul(a, b, c, row, inner, col);
+    basic_buffer(c, C);
+    return true;
+}
+
+template <typename T>
+static bool numeric_solve_dense(const vec_basic &A, const vec_basic &b,
+                                vec_basic &x, unsigned n, unsigned bcol)
+{
+    std::vector<T> a, y;
+    if (not numeric_buffer(A, a) or not numeric_buffer(b, y)
+        or not numeric_solve(std::move(a), y, n, bcol)) {
+        return false;
+    }
+    basic_buffer(y, x);
+    return true;
+}
+
+// Solves `A x = b` on numeric buffers if possible, returns false otherwise
+static bool solve_numeric(const DenseMatrix &A, const DenseMatrix &b,
+                          DenseMatrix &x)
+{
+    SYMENGINE_ASSERT(A.nrows() == A.ncols() and b.nrows() == A.nrows()
+                     and x.nrows() == b.nrows() and x.ncols() == b.ncols());
+    const vec_basic a = A.as_vec_basic(), y = b.as_vec_basic();
+    vec_basic res;
+    if (numeric_solve_dense<rational_class>(a, y, res, A.nrows(), b.ncols())
+        or numeric_solve_dense<double>(a, y, res, A.nrows(), b.ncols())) {
+        x = DenseMatrix(x.nrows(), x.ncols(), res);
+        return true;
+    }
+    return false;
 }
 
 // ----------------------------- Matrix Conjugate ----------------------------//
@@ -684,14 +1034,33 @@ void mul_dense_dense(const DenseMatrix &A, const DenseMatrix &B, DenseMatrix &C)
 
     unsigned row = A.row_, col = B.col_;
 
+    if (numeric_mul_dense_dense<integer_class>(A.m_, B.m_, C.m_, row, A.col_,
+                                               col)
+        or numeric_mul_dense_dense<rational_class>(A.m_, B.m_, C.m_, row,
+                                                   A.col_, col)
+        or numeric_mul_dense_dense<double>(A.m_, B.m_, C.m_, row, A.col_,
+                                           col)) {
+        return;
+    }
+
     if (&A != &C and &B != &C) {
+        // Every entry is accumulated into a single dictionary, instead of
+        // canonicalizing a growing Add for each of the products
+#pragma omp parallel for
         for (unsigned r = 0; r < row; r++) {
+            umap_basic_num d;
             for (unsigned c = 0; c < col; c++) {
-                C.m_[r * col + c] = zero; // Integer Zero
-                for (unsigned k = 0; k < A.col_; k++)
-                    C.m_[r * col + c]
-                        = add(C.m_[r * col + c],
-                              mul(A.m_[r * A.col_ + k], B.m_[k * col + c]));
+                RCP<const Number> coef = zero;
+                for (unsigned k = 0; k < A.col_; k++) {
+                    const RCP<const Basic> &a = A.m_[r * A.col_ + k];
+                    const RCP<const Basic> &b = B.m_[k * col + c];
+                    if (is_number_and_zero(*a) or is_number_and_zero(*b)) {
+                        continue;
+                    }
+                    Add::coef_dict_add_term(outArg(coef), d, one, mul(a, b));
+                }
+                C.m_[r * col + c] = Add::from_dict(coef, std::move(d));
+                d.clear();
             }
         }
     } else {
@@ -1304,6 +1673,9 @@ void fraction_free_gauss_jordan_solve(const DenseMatrix &A,
 void fraction_free_LU_solve(const DenseMatrix &A, const DenseMatrix &b,
                             DenseMatrix &x)
 {
+    if (solve_numeric(A, b, x)) {
+        return;
+    }
     DenseMatrix LU = DenseMatrix(A.nrows(), A.ncols());
     DenseMatrix x_ = DenseMatrix(b.nrows(), b.ncols());
 
@@ -1314,6 +1686,9 @@ void fraction_free_LU_solve(const DenseMatrix &A, const DenseMatrix &b,
 
 void LU_solve(const DenseMatrix &A, const DenseMatrix &b, DenseMatrix &x)
 {
+    if (solve_numeric(A, b, x)) {
+        return;
+    }
     DenseMatrix L = DenseMatrix(A.nrows(), A.ncols());
     DenseMatrix U = DenseMatrix(A.nrows(), A.ncols());
     DenseMatrix x_ = DenseMatrix(b.nrows(), b.ncols());
@@ -1326,6 +1701,9 @@ void LU_solve(const DenseMatrix &A, const DenseMatrix &b, DenseMatrix &x)
 void pivoted_LU_solve(const DenseMatrix &A, const DenseMatrix &b,
                       DenseMatrix &x)
 {
+    if (solve_numeric(A, b, x)) {
+        return;
+    }
     DenseMatrix L = DenseMatrix(A.nrows(), A.ncols());
     DenseMatrix U = DenseMatrix(A.nrows(), A.ncols());
     DenseMatrix x_ = DenseMatrix(b);
@@ -1395,6 +1773,26 @@ void LU(const DenseMatrix &A, DenseMatrix &L, DenseMatrix &U)
     unsigned i, j, k;
     RCP<const Basic> scale;
 
+    std::vector<rational_class> q;
+    std::vector<double> d;
+    bool exact = numeric_buffer(A.m_, q) and numeric_LU(q, n);
+    if (exact or (numeric_buffer(A.m_, d) and numeric_LU(d, n))) {
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < n; j++) {
+                RCP<const Basic> e = exact ? numeric_to_basic(q[i * n + j])
+                                           : numeric_to_basic(d[i * n + j]);
+                if (i > j) {
+                    L.m_[i * n + j] = e;
+                    U.m_[i * n + j] = zero; // Integer zero
+                } else {
+                    L.m_[i * n + j] = (i == j) ? one : zero;
+                    U.m_[i * n + j] = e;
+                }
+            }
+        }
+        return;
+    }
+
     U.m_ = A.m_;
 
     for (j = 0; j < n; j++) {
@@ -1709,6 +2107,17 @@ RCP<const Basic> det_bareis(const DenseMatrix &A)
                        mul(mul(A.m_[0], A.m_[5]), A.m_[7])));
     } else {
 
+        std::vector<integer_class> z;
+        std::vector<rational_class> q;
+        std::vector<double> v;
+        if (numeric_buffer(A.m_, z)) {
+            return numeric_to_basic(numeric_det(std::move(z), n));
+        } else if (numeric_buffer(A.m_, q)) {
+            return numeric_to_basic(numeric_det(std::move(q), n));
+        } else if (numeric_buffer(A.m_, v)) {
+            return numeric_to_basic(numeric_det(std::move(v), n));
+        }
+
         if (A.is_lower() or A.is_upper()) {
             RCP<const Basic> det = A.m_[0];
             for (unsigned i = 1; i < n; ++i) {
@@ -1838,6 +2247,281 @@ RCP<const Basic> det_berkowitz(const DenseMatrix &A)
     return poly.get(poly.nrows() - 1, 0);
 }
 
+// ------------------------- Multi-modular Algorithms ------------------------//
+// Integer and rational matrices are handled modulo many word size primes, so
+// that no intermediate result grows beyond a machine word. The images are
+// recombined with `crt` once there are enough primes to exceed the Hadamard
+// bound of the result.
+
+// Integer entries of the rows of `[A | b]` scaled by the lcm of their
+// denominators, which are stored in `scale`. Returns false if an entry is
+// neither an Integer nor a Rational.
+static bool integer_rows(const DenseMatrix &A, const DenseMatrix *b,
+                         std::vector<integer_class> &a,
+                         std::vector<integer_class> &c,
+                         std::vector<integer_class> &scale)
+{
+    const unsigned n = A.nrows(), m = A.ncols();
+    const unsigned bcol = b ? b->ncols() : 0;
+    std::vector<rational_class> q(m), r(bcol);
+    a.resize(n * m);
+    c.resize(n * bcol);
+    scale.assign(n, integer_class(1));
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned j = 0; j < m; j++) {
+            if (A.get(i, j).is_null() or not numeric_value(*A.get(i, j), q[j]))
+                return false;
+            mp_lcm(scale[i], scale[i], get_den(q[j]));
+        }
+        for (unsigned j = 0; j < bcol; j++) {
+            if (b->get(i, j).is_null()
+                or not numeric_value(*b->get(i, j), r[j]))
+                return false;
+            mp_lcm(scale[i], scale[i], get_den(r[j]));
+        }
+        for (unsigned j = 0; j < m; j++)
+            a[i * m + j] = get_num(q[j]) * (scale[i] / get_den(q[j]));
+        for (unsigned j = 0; j < bcol; j++)
+            c[i * bcol + j] = get_num(r[j]) * (scale[i] / get_den(r[j]));
+    }
+    return true;
+}
+
+// Square of twice the Hadamard bound of the rows of `[A | b]`. It bounds the
+// square of twice the absolute value of det(A) and of every minor obtained by
+// replacing a column of A by a column of b.
+static integer_class hadamard_bound(const std::vector<integer_class> &a,
+                                    const std::vector<integer_class> &c,
+                                    unsigned n, unsigned bcol)
+{
+    integer_class bound(4), row, rhs;
+    for (unsigned i = 0; i < n; i++) {
+        row = 0;
+        for (unsigned j = 0; j < n; j++)
+            row += a[i * n + j] * a[i * n + j];
+        rhs = 0;
+        for (unsigned j = 0; j < bcol; j++)
+            if (c[i * bcol + j] * c[i * bcol + j] > rhs)
+                rhs = c[i * bcol + j] * c[i * bcol + j];
+        bound *= row + rhs;
+    }
+    return bound;
+}
+
+// Appends the next prime below the last one of `primes`, starting at 2^31
+static void add_word_prime(std::vector<uint64_t> &primes)
+{
+    uint64_t p = primes.empty() ? (uint64_t(1) << 31) : primes.back();
+    do {
+        p--;
+    } while (probab_prime_p(*integer(static_cast<unsigned long>(p))) == 0);
+    primes.push_back(p);
+}
+
+static uint64_t powmod_word(uint64_t a, uint64_t e, uint64_t p)
+{
+    uint64_t r = 1;
+    a %= p;
+    while (e > 0) {
+        if (e & 1)
+            r = r * a % p;
+        a = a * a % p;
+        e >>= 1;
+    }
+    return r;
+}
+
+// Gaussian elimination of the `n x n` matrix `a` modulo `p`, applied to the
+// `n x bcol` matrix `b` as well. Returns det(a) mod p and, if it is nonzero,
+// replaces `b` by det(a) a^-1 b mod p.
+static uint64_t eliminate_mod(std::vector<uint64_t> a, std::vector<uint64_t> &b,
+                              unsigned n, unsigned bcol, uint64_t p)
+{
+    uint64_t det = 1;
+    for (unsigned k = 0; k < n; k++) {
+        unsigned piv = k;
+        while (piv < n and a[piv * n + k] == 0)
+            piv++;
+        if (piv == n)
+            return 0;
+        if (piv != k) {
+            for (unsigned j = k; j < n; j++)
+                std::swap(a[piv * n + j], a[k * n + j]);
+            for (unsigned j = 0; j < bcol; j++)
+                std::swap(b[piv * bcol + j], b[k * bcol + j]);
+            det = p - det;
+        }
+        det = det * a[k * n + k] % p;
+        const uint64_t inv = powmod_word(a[k * n + k], p - 2, p);
+        for (unsigned i = k + 1; i < n; i++) {
+            if (a[i * n + k] == 0)
+                continue;
+            const uint64_t f = p - a[i * n + k] * inv % p;
+            for (unsigned j = k + 1; j < n; j++)
+                a[i * n + j] = (a[i * n + j] + f * a[k * n + j]) % p;
+            for (unsigned j = 0; j < bcol; j++)
+                b[i * bcol + j] = (b[i * bcol + j] + f * b[k * bcol + j]) % p;
+        }
+    }
+    for (unsigned k = n; k-- > 0;) {
+        const uint64_t inv = powmod_word(a[k * n + k], p - 2, p);
+        for (unsigned j = 0; j < bcol; j++) {
+            uint64_t s = b[k * bcol + j];
+            for (unsigned i = k + 1; i < n; i++)
+                s = (s + (p - a[k * n + i]) * b[i * bcol + j]) % p;
+            b[k * bcol + j] = s * inv % p;
+        }
+    }
+    for (auto &e : b)
+        e = e * det % p;
+    return det;
+}
+
+static std::vector<uint64_t> reduce_mod(const std::vector<integer_class> &v,
+                                        uint64_t p)
+{
+    std::vector<uint64_t> r(v.size());
+    integer_class t, m(static_cast<unsigned long>(p));
+    for (size_t i = 0; i < v.size(); i++) {
+        mp_fdiv_r(t, v[i], m);
+        r[i] = mp_get_ui(t);
+    }
+    return r;
+}
+
+// The integer of least absolute value with the given residues modulo `primes`
+static integer_class crt_symmetric(const std::vector<uint64_t> &residues,
+                                   const std::vector<uint64_t> &primes,
+                                   const integer_class &modulus)
+{
+    std::vector<RCP<const Integer>> rem, mod;
+    for (size_t i = 0; i < primes.size(); i++) {
+        rem.push_back(integer(static_cast<unsigned long>(residues[i])));
+        mod.push_back(integer(static_cast<unsigned long>(primes[i])));
+    }
+    RCP<const Integer> r;
+    crt(outArg(r), rem, mod);
+    integer_class res = r->as_integer_class();
+    if (2 * res > modulus)
+        res -= modulus;
+    return res;
+}
+
+// Computes det(a) and, if it is nonzero and `bcol > 0`, y = det(a) a^-1 c for
+// the integer `n x n` matrix `a` and `n x bcol` matrix `c`, modulo enough
+// primes to recover them. Primes dividing det(a) are skipped when solving.
+static integer_class modular_det_solve(const std::vector<integer_class> &a,
+                                       const std::vector<integer_class> &c,
+                                       unsigned n, unsigned bcol,
+                                       std::vector<integer_class> &y)
+{
+    const integer_class bound = hadamard_bound(a, c, n, bcol);
+    std::vector<uint64_t> primes, good, dets;
+    std::vector<std::vector<uint64_t>> ys;
+    integer_class modulus(1), all_primes(1);
+    bool zero_det = true;
+
+    while (modulus * modulus <= bound) {
+        // Pick enough new primes assuming all of them are usable
+        const size_t first = primes.size();
+        integer_class m = modulus;
+        while (m * m <= bound) {
+            add_word_prime(primes);
+            m *= static_cast<unsigned long>(primes.back());
+            all_primes *= static_cast<unsigned long>(primes.back());
+        }
+        const size_t count = primes.size() - first;
+        std::vector<uint64_t> d(count);
+        std::vector<std::vector<uint64_t>> b(count);
+#pragma omp parallel for schedule(dynamic)
+        for (size_t i = 0; i < count; i++) {
+            const uint64_t p = primes[first + i];
+            b[i] = reduce_mod(c, p);
+            d[i] = eliminate_mod(reduce_mod(a, p), b[i], n, bcol, p);
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (d[i] != 0)
+                zero_det = false;
+            // When solving, a prime dividing det(a) gives no image of y
+            if (d[i] != 0 or bcol == 0) {
+                good.push_back(primes[first + i]);
+                dets.push_back(d[i]);
+                ys.push_back(std::move(b[i]));
+                modulus *= static_cast<unsigned long>(primes[first + i]);
+            }
+        }
+        if (zero_det and all_primes * all_primes > bound) {
+            // The product of the primes dividing det(a) exceeds its bound
+            y.clear();
+            return integer_class(0);
+        }
+    }
+
+    integer_class det = crt_symmetric(dets, good, modulus);
+    y.resize(n * bcol);
+    if (det != 0) {
+        std::vector<uint64_t> res(good.size());
+        for (unsigned k = 0; k < n * bcol; k++) {
+            for (size_t i = 0; i < good.size(); i++)
+                res[i] = ys[i][k];
+            y[k] = crt_symmetric(res, good, modulus);
+        }
+    }
+    return det;
+}
+
+static bool try_det_modular(const DenseMatrix &A, RCP<const Basic> &det)
+{
+    SYMENGINE_ASSERT(A.nrows() == A.ncols());
+    std::vector<integer_class> a, c, scale, y;
+    if (not integer_rows(A, nullptr, a, c, scale))
+        return false;
+    integer_class den(1);
+    for (const auto &s : scale)
+        den *= s;
+    integer_class d = modular_det_solve(a, c, A.nrows(), 0, y);
+    det = Rational::from_two_ints(*integer(std::move(d)),
+                                  *integer(std::move(den)));
+    return true;
+}
+
+static bool try_modular_solve(const DenseMatrix &A, const DenseMatrix &b,
+                              DenseMatrix &x)
+{
+    SYMENGINE_ASSERT(A.nrows() == A.ncols() and b.nrows() == A.nrows()
+                     and x.nrows() == b.nrows() and x.ncols() == b.ncols());
+    std::vector<integer_class> a, c, scale, y;
+    if (not integer_rows(A, &b, a, c, scale))
+        return false;
+    const unsigned n = A.nrows(), bcol = b.ncols();
+    integer_class d = modular_det_solve(a, c, n, bcol, y);
+    if (d == 0)
+        return false;
+    RCP<const Integer> det = integer(std::move(d));
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < bcol; j++)
+            x.set(i, j,
+                  Rational::from_two_ints(*integer(std::move(y[i * bcol + j])),
+                                          *det));
+    return true;
+}
+
+RCP<const Basic> det_modular(const DenseMatrix &A)
+{
+    RCP<const Basic> det;
+    if (not try_det_modular(A, det))
+        throw SymEngineException(
+            "det_modular requires Integer or Rational entries");
+    return det;
+}
+
+void modular_solve(const DenseMatrix &A, const DenseMatrix &b, DenseMatrix &x)
+{
+    if (not try_modular_solve(A, b, x))
+        throw SymEngineException("modular_solve requires a nonsingular matrix "
+                                 "with Integer or Rational entries");
+}
+
 void char_poly(const DenseMatrix &A, DenseMatrix &B)
 {
     SYMENGINE_ASSERT(B.ncols() == 1 and B.nrows() == A.nrows() + 1);
@@ -1926,7 +2610,9 @@ void inverse_gauss_jordan(const DenseMatrix &A, DenseMatrix &B)
             B.m_[i * n + j] = zero;
         }
 
-    fraction_free_gauss_jordan_solve(A, e, B);
+    if (not solve_numeric(A, e, B)) {
+        fraction_free_gauss_jordan_solve(A, e, B);
+    }
 }
 
 // ----------------------- Vector-specific Methods --------------------------//
@@ -1,3 +1,4 @@
+#include <limits>
 #include <symengine/visitor.h>
 #include <symengine/subs.h>
 #include <symengine/symengine_casts.h>
@@ -934,6 +935,14 @@ const RCP<const Basic> &DiffVisitor::apply(const Basic &b)
 
 const RCP<const Basic> &DiffVisitor::apply(const RCP<const Basic> &b)
 {
+    // Sets, booleans, tuples and matrices do not have a scalar zero
+    // derivative, everything else not containing `x` does
+    if ((b->symbol_signature() & symbol_signature_bit(*x)) == 0
+        and not is_a_Set(*b) and not is_a_Boolean(*b) and not is_a<Tuple>(*b)
+        and not is_a_MatrixExpr(*b)) {
+        result_ = zero;
+        return result_;
+    }
     if (not cache) {
         b->accept(*this);
         return result_;
@@ -974,4 +983,153 @@ RCP<const Basic> sdiff(const RCP<const Basic> &arg, const RCP<const Basic> &x,
     }
 }
 
+// Reverse mode differentiation. The DAG of the expression is traversed once
+// to collect the nodes that depend on one of the symbols in post-order, then
+// the adjoints are propagated from the root towards the leaves. The adjoint
+// of a node is shared by the contributions to all of its children.
+class ReverseDiff
+{
+    static const unsigned independent = std::numeric_limits<unsigned>::max();
+    // Index of the distinct symbols
+    umap_basic_uint symbols_;
+    // Position of a node in `nodes_`, or `independent`
+    umap_basic_uint visited_;
+    vec_basic nodes_;
+    // Contributions to the adjoints of the nodes and of the symbols
+    std::vector<vec_basic> adjoints_;
+    std::vector<vec_basic> symbol_adjoints_;
+
+    bool visit(const RCP<const Basic> &b)
+    {
+        auto it = visited_.find(b);
+        if (it != visited_.end()) {
+            return it->second != independent;
+        }
+        bool dep = false;
+        if (is_a<Symbol>(*b)) {
+            dep = symbols_.find(b) != symbols_.end();
+        } else if (is_a<Add>(*b)) {
+            for (const auto &p : down_cast<const Add &>(*b).get_dict()) {
+                dep = visit(p.first) or dep;
+            }
+        } else if (is_a<Mul>(*b)) {
+            for (const auto &p : down_cast<const Mul &>(*b).get_dict()) {
+                dep = visit(p.first) or dep;
+                dep = visit(p.second) or dep;
+            }
+        } else if (is_a<Pow>(*b)) {
+            const Pow &self = down_cast<const Pow &>(*b);
+            dep = visit(self.get_base());
+            dep = visit(self.get_exp()) or dep;
+        } else if (is_a_sub<OneArgFunction>(*b)) {
+            dep = visit(down_cast<const OneArgFunction &>(*b).get_arg());
+        } else if (not is_a_Number(*b) and not is_a<Constant>(*b)) {
+            for (const auto &s : free_symbols(*b)) {
+                if (symbols_.find(s) != symbols_.end()) {
+                    dep = true;
+                    break;
+                }
+            }
+        }
+        if (dep) {
+            visited_.insert({b, static_cast<unsigned>(nodes_.size())});
+            nodes_.push_back(b);
+        } else {
+            visited_.insert({b, independent});
+        }
+        return dep;
+    }
+
+    bool depends(const RCP<const Basic> &b) const
+    {
+        return visited_.find(b)->second != independent;
+    }
+
+    // Add `partial * adjoint` to the adjoint of `b`
+    void push(const RCP<const Basic> &b, const RCP<const Basic> &partial,
+              const RCP<const Basic> &adjoint)
+    {
+        adjoints_[visited_.find(b)->second].push_back(mul(partial, adjoint));
+    }
+
+    void propagate(const RCP<const Basic> &b, const RCP<const Basic> &adjoint)
+    {
+        if (is_a<Symbol>(*b)) {
+            symbol_adjoints_[symbols_.find(b)->second].push_back(adjoint);
+        } else if (is_a<Add>(*b)) {
+            for (const auto &p : down_cast<const Add &>(*b).get_dict()) {
+                if (depends(p.first)) {
+                    push(p.first, p.second, adjoint);
+                }
+            }
+        } else if (is_a<Mul>(*b)) {
+            for (const auto &p : down_cast<const Mul &>(*b).get_dict()) {
+                if (depends(p.first)) {
+                    push(p.first, mul(p.second, div(b, p.first)), adjoint);
+                }
+                if (depends(p.second)) {
+                    push(p.second, mul(b, log(p.first)), adjoint);
+                }
+            }
+        } else if (is_a<Pow>(*b)) {
+            const Pow &self = down_cast<const Pow &>(*b);
+            RCP<const Basic> base = self.get_base();
+            RCP<const Basic> exp = self.get_exp();
+            if (depends(base)) {
+                push(base, mul(exp, pow(base, sub(exp, one))), adjoint);
+            }
+            if (depends(exp)) {
+                push(exp, mul(b, log(base)), adjoint);
+            }
+        } else if (is_a_sub<OneArgFunction>(*b)) {
+            const OneArgFunction &self = down_cast<const OneArgFunction &>(*b);
+            const RCP<const Symbol> d = dummy();
+            push(self.get_arg(),
+                 subs(self.create(d)->diff(d), {{d, self.get_arg()}}),
+                 adjoint);
+        } else {
+            // Fall back to forward mode for the other nodes
+            for (const auto &s : free_symbols(*b)) {
+                auto it = symbols_.find(s);
+                if (it != symbols_.end()) {
+                    symbol_adjoints_[it->second].push_back(mul(
+                        b->diff(rcp_static_cast<const Symbol>(s)), adjoint));
+                }
+            }
+        }
+    }
+
+public:
+    vec_basic apply(const RCP<const Basic> &b, const vec_sym &x)
+    {
+        for (const auto &s : x) {
+            symbols_.insert({s, static_cast<unsigned>(symbols_.size())});
+        }
+        symbol_adjoints_.resize(symbols_.size());
+        if (visit(b)) {
+            adjoints_.resize(nodes_.size());
+            adjoints_.back().push_back(one);
+            // Every node is processed after all the nodes that contain it
+            for (size_t k = nodes_.size(); k-- > 0;) {
+                propagate(nodes_[k], add(adjoints_[k]));
+                adjoints_[k].clear();
+            }
+        }
+        vec_basic result;
+        result.reserve(x.size());
+        for (const auto &s : x) {
+            result.push_back(add(symbol_adjoints_[symbols_.find(s)->second]));
+        }
+        return result;
+    }
+};
+
+const unsigned ReverseDiff::independent;
+
+vec_basic gradient(const RCP<const Basic> &expr, const vec_sym &x)
+{
+    ReverseDiff v;
+    return v.apply(expr, x);
+}
+
 } // namespace SymEngine
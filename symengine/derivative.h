@@ -21,6 +21,11 @@ RCP<const Basic> diff(const RCP<const Basic> &arg, const RCP<const Symbol> &x,
 RCP<const Basic> sdiff(const RCP<const Basic> &arg, const RCP<const Basic> &x,
                        bool cache = true);
 
+//! Gradient of `expr` w.r.t the symbols `x` using reverse mode
+//! differentiation. The expression is traversed only once and the entries
+//! of the result share their common subexpressions.
+vec_basic gradient(const RCP<const Basic> &expr, const vec_sym &x);
+
 class DiffVisitor : public BaseVisitor<DiffVisitor>
 {
 protected:
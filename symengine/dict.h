@@ -6,9 +6,11 @@
 
 #ifndef SYMENGINE_DICT_H
 #define SYMENGINE_DICT_H
+#include <symengine/symengine_rcp.h>
 #include <symengine/mp_class.h>
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <map>
 #include <vector>
 #include <unordered_map>
@@ -30,8 +32,19 @@ struct RCPIntegerKeyLess;
 
 bool eq(const Basic &, const Basic &);
 typedef uint64_t hash_t;
-typedef std::unordered_map<RCP<const Basic>, RCP<const Number>, RCPBasicHash,
-                           RCPBasicKeyEq>
+
+//! Allocator of the dictionaries that are filled in the hot arithmetic loops
+#if defined(WITH_SYMENGINE_POOL_ALLOCATOR)
+template <class T>
+using dict_allocator = PoolAllocator<T>;
+#else
+template <class T>
+using dict_allocator = std::allocator<T>;
+#endif
+
+typedef std::unordered_map<
+    RCP<const Basic>, RCP<const Number>, RCPBasicHash, RCPBasicKeyEq,
+    dict_allocator<std::pair<const RCP<const Basic>, RCP<const Number>>>>
     umap_basic_num;
 typedef std::unordered_map<short, RCP<const Basic>> umap_short_basic;
 typedef std::unordered_map<int, RCP<const Basic>> umap_int_basic;
@@ -53,7 +66,9 @@ typedef std::map<vec_uint, unsigned long long int> map_vec_uint;
 typedef std::map<vec_uint, integer_class> map_vec_mpz;
 typedef std::map<RCP<const Basic>, RCP<const Number>, RCPBasicKeyLess>
     map_basic_num;
-typedef std::map<RCP<const Basic>, RCP<const Basic>, RCPBasicKeyLess>
+typedef std::map<
+    RCP<const Basic>, RCP<const Basic>, RCPBasicKeyLess,
+    dict_allocator<std::pair<const RCP<const Basic>, RCP<const Basic>>>>
     map_basic_basic;
 typedef std::map<RCP<const Integer>, unsigned, RCPIntegerKeyLess>
     map_integer_uint;
@@ -121,15 +136,16 @@ inline bool unified_eq(const std::multiset<T, U> &a,
     return ordered_eq(a, b);
 }
 
-template <typename K, typename V, typename C>
-inline bool unified_eq(const std::map<K, V, C> &a, const std::map<K, V, C> &b)
+template <typename K, typename V, typename C, typename A>
+inline bool unified_eq(const std::map<K, V, C, A> &a,
+                       const std::map<K, V, C, A> &b)
 {
     return ordered_eq(a, b);
 }
 
-template <typename K, typename V, typename H, typename E>
-inline bool unified_eq(const std::unordered_map<K, V, H, E> &a,
-                       const std::unordered_map<K, V, H, E> &b)
+template <typename K, typename V, typename H, typename E, typename A>
+inline bool unified_eq(const std::unordered_map<K, V, H, E, A> &a,
+                       const std::unordered_map<K, V, H, E, A> &b)
 {
     return unordered_eq(a, b);
 }
@@ -250,16 +266,16 @@ inline int unified_compare(const std::pair<T, U> &a, const std::pair<T, U> &b)
     }
 }
 
-template <typename K, typename V, typename C>
-inline int unified_compare(const std::map<K, V, C> &a,
-                           const std::map<K, V, C> &b)
+template <typename K, typename V, typename C, typename A>
+inline int unified_compare(const std::map<K, V, C, A> &a,
+                           const std::map<K, V, C, A> &b)
 {
     return ordered_compare(a, b);
 }
 
-template <typename K, typename V, typename H, typename E>
-inline int unified_compare(const std::unordered_map<K, V, H, E> &a,
-                           const std::unordered_map<K, V, H, E> &b)
+template <typename K, typename V, typename H, typename E, typename A>
+inline int unified_compare(const std::unordered_map<K, V, H, E, A> &a,
+                           const std::unordered_map<K, V, H, E, A> &b)
 {
     return unordered_compare(a, b);
 }
@@ -51,28 +51,45 @@ public:
 #endif
     void bvisit(const Add &x)
     {
-        T tmp = 0;
-        for (const auto &p : x.get_args())
-            tmp += apply(*p);
+        T tmp = apply(*x.get_coef());
+        x.for_each_term([&](const RCP<const Number> &coef,
+                            const RCP<const Basic> &term) {
+            if (coef->is_one()) {
+                tmp += apply(*term);
+            } else {
+                tmp += apply(*coef) * apply(*term);
+            }
+        });
         result_ = tmp;
     }
 
     void bvisit(const Mul &x)
     {
-        T tmp = 1;
-        for (const auto &p : x.get_args())
-            tmp *= apply(*p);
+        T tmp = apply(*x.get_coef());
+        x.for_each_factor(
+            [&](const RCP<const Basic> &base, const RCP<const Basic> &exp) {
+                tmp *= eval_pow(*base, *exp);
+            });
         result_ = tmp;
     }
 
     void bvisit(const Pow &x)
     {
-        T exp_ = apply(*(x.get_exp()));
-        if (eq(*(x.get_base()), *E)) {
-            result_ = std::exp(exp_);
+        result_ = eval_pow(*x.get_base(), *x.get_exp());
+    }
+
+    T eval_pow(const Basic &base, const Basic &exp)
+    {
+        if (is_a<Integer>(exp)
+            and down_cast<const Integer &>(exp).is_one()) {
+            return apply(base);
+        }
+        T exp_ = apply(exp);
+        if (eq(base, *E)) {
+            return std::exp(exp_);
         } else {
-            T base_ = apply(*(x.get_base()));
-            result_ = std::pow(base_, exp_);
+            T base_ = apply(base);
+            return std::pow(base_, exp_);
         }
     }
 
@@ -478,15 +495,23 @@ static inline std::vector<fn> init_eval_double()
     };
 #endif
     table[SYMENGINE_ADD] = [](const Basic &x) {
-        double tmp = 0;
-        for (const auto &p : x.get_args())
-            tmp += eval_double_single_dispatch(*p);
+        const Add &a = down_cast<const Add &>(x);
+        double tmp = eval_double_single_dispatch(*a.get_coef());
+        a.for_each_term([&](const RCP<const Number> &coef,
+                            const RCP<const Basic> &term) {
+            tmp += eval_double_single_dispatch(*coef)
+                   * eval_double_single_dispatch(*term);
+        });
         return tmp;
     };
     table[SYMENGINE_MUL] = [](const Basic &x) {
-        double tmp = 1;
-        for (const auto &p : x.get_args())
-            tmp *= eval_double_single_dispatch(*p);
+        const Mul &m = down_cast<const Mul &>(x);
+        double tmp = eval_double_single_dispatch(*m.get_coef());
+        m.for_each_factor(
+            [&](const RCP<const Basic> &base, const RCP<const Basic> &exp) {
+                tmp *= ::pow(eval_double_single_dispatch(*base),
+                             eval_double_single_dispatch(*exp));
+            });
         return tmp;
     };
     table[SYMENGINE_POW] = [](const Basic &x) {
@@ -46,40 +46,47 @@ public:
 
     void bvisit(const Add &x)
     {
-        mpfr_class t(mpfr_get_prec(result_));
-        auto d = x.get_args();
-        auto p = d.begin();
-        apply(result_, *(*p));
-        p++;
-        for (; p != d.end(); p++) {
-            apply(t.get_mpfr_t(), *(*p));
+        mpfr_class t(mpfr_get_prec(result_)), c(mpfr_get_prec(result_));
+        apply(result_, *x.get_coef());
+        x.for_each_term([&](const RCP<const Number> &coef,
+                            const RCP<const Basic> &term) {
+            apply(t.get_mpfr_t(), *term);
+            if (neq(*coef, *one)) {
+                apply(c.get_mpfr_t(), *coef);
+                mpfr_mul(t.get_mpfr_t(), t.get_mpfr_t(), c.get_mpfr_t(), rnd_);
+            }
             mpfr_add(result_, result_, t.get_mpfr_t(), rnd_);
-        }
+        });
     }
 
     void bvisit(const Mul &x)
     {
         mpfr_class t(mpfr_get_prec(result_));
-        auto d = x.get_args();
-        auto p = d.begin();
-        apply(result_, *(*p));
-        p++;
-        for (; p != d.end(); p++) {
-            apply(t.get_mpfr_t(), *(*p));
-            mpfr_mul(result_, result_, t.get_mpfr_t(), rnd_);
-        }
+        apply(result_, *x.get_coef());
+        x.for_each_factor(
+            [&](const RCP<const Basic> &base, const RCP<const Basic> &exp) {
+                eval_pow(t.get_mpfr_t(), *base, *exp);
+                mpfr_mul(result_, result_, t.get_mpfr_t(), rnd_);
+            });
     }
 
     void bvisit(const Pow &x)
     {
-        if (eq(*x.get_base(), *E)) {
-            apply(result_, *(x.get_exp()));
-            mpfr_exp(result_, result_, rnd_);
+        eval_pow(result_, *x.get_base(), *x.get_exp());
+    }
+
+    void eval_pow(mpfr_ptr result, const Basic &base, const Basic &exp)
+    {
+        if (eq(exp, *one)) {
+            apply(result, base);
+        } else if (eq(base, *E)) {
+            apply(result, exp);
+            mpfr_exp(result, result, rnd_);
         } else {
-            mpfr_class b(mpfr_get_prec(result_));
-            apply(b.get_mpfr_t(), *(x.get_base()));
-            apply(result_, *(x.get_exp()));
-            mpfr_pow(result_, b.get_mpfr_t(), result_, rnd_);
+            mpfr_class b(mpfr_get_prec(result));
+            apply(b.get_mpfr_t(), base);
+            apply(result, exp);
+            mpfr_pow(result, b.get_mpfr_t(), result, rnd_);
         }
     }
 
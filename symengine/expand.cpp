@@ -1,4 +1,5 @@
 #include <symengine/visitor.h>
+#include <symengine/rings.h>
 
 namespace SymEngine
 {
@@ -26,9 +27,13 @@ private:
     RCP<const Number> coeff = zero;
     RCP<const Number> multiply = one;
     bool deep;
+    unsigned nthreads;
 
 public:
-    ExpandVisitor(bool deep_ = true) : deep(deep_) {}
+    ExpandVisitor(bool deep_ = true, unsigned nthreads_ = 1)
+        : deep(deep_), nthreads(nthreads_)
+    {
+    }
     RCP<const Basic> apply(const Basic &b)
     {
         b.accept(*this);
@@ -215,75 +220,120 @@ public:
         map_vec_mpz r;
         unsigned m = numeric_cast<unsigned>(base_dict.size());
         multinomial_coefficients_mpz(m, n, r);
+#if defined(_OPENMP)
+        if (nthreads > 1) {
+            return pow_expand_parallel(base_dict, r);
+        }
+#endif
 // This speeds up overall expansion. For example for the benchmark
 // (y + x + z + w)**60 it improves the timing from 135ms to 124ms.
 #if defined(HAVE_SYMENGINE_RESERVE)
         d_.reserve(d_.size() + 2 * r.size());
 #endif
         for (auto &p : r) {
-            auto power = p.first.begin();
-            auto i2 = base_dict.begin();
-            map_basic_basic d;
-            RCP<const Number> overall_coeff = one;
-            for (; power != p.first.end(); ++power, ++i2) {
-                if (*power > 0) {
-                    RCP<const Integer> exp = integer(std::move(*power));
-                    RCP<const Basic> base = i2->first;
-                    if (is_a<Integer>(*base)) {
-                        _imulnum(outArg(overall_coeff),
-                                 rcp_static_cast<const Number>(
-                                     down_cast<const Integer &>(*base).powint(
-                                         *exp)));
-                    } else if (is_a<Symbol>(*base)) {
-                        Mul::dict_add_term(d, exp, base);
-                    } else {
-                        RCP<const Basic> exp2, t, tmp;
-                        tmp = pow(base, exp);
-                        if (is_a<Mul>(*tmp)) {
-                            for (auto &p :
-                                 (down_cast<const Mul &>(*tmp)).get_dict()) {
-                                Mul::dict_add_term_new(outArg(overall_coeff), d,
-                                                       p.second, p.first);
-                            }
-                            _imulnum(outArg(overall_coeff),
-                                     (down_cast<const Mul &>(*tmp)).get_coef());
-                        } else if (is_a_Number(*tmp)) {
-                            _imulnum(outArg(overall_coeff),
-                                     rcp_static_cast<const Number>(tmp));
-                        } else {
-                            Mul::as_base_exp(tmp, outArg(exp2), outArg(t));
-                            Mul::dict_add_term_new(outArg(overall_coeff), d,
-                                                   exp2, t);
+            pow_expand_term(base_dict, p, d_, coeff);
+        }
+    }
+
+#if defined(_OPENMP)
+    // The terms of the multinomial expansion are independent, so they are
+    // distributed over the threads, each accumulating into its own dictionary
+    // that is merged into `d_` at the end.
+    void pow_expand_parallel(const umap_basic_num &base_dict,
+                             const map_vec_mpz &r)
+    {
+        std::vector<const map_vec_mpz::value_type *> terms;
+        terms.reserve(r.size());
+        for (auto &p : r) {
+            terms.push_back(&p);
+        }
+        const long nterms = numeric_cast<long>(terms.size());
+#pragma omp parallel num_threads(nthreads)
+        {
+            umap_basic_num d;
+            RCP<const Number> c = zero;
+#pragma omp for schedule(dynamic, 16)
+            for (long i = 0; i < nterms; i++) {
+                pow_expand_term(base_dict, *terms[i], d, c);
+            }
+#pragma omp critical
+            {
+                iaddnum(outArg(coeff), c);
+                for (auto &q : d) {
+                    Add::dict_add_term(d_, q.second, q.first);
+                }
+            }
+        }
+    }
+#endif
+
+    // Adds the term of the multinomial expansion with exponents `p.first` and
+    // coefficient `p.second` into `d` and `c`
+    void pow_expand_term(const umap_basic_num &base_dict,
+                         const map_vec_mpz::value_type &p, umap_basic_num &d,
+                         RCP<const Number> &c) const
+    {
+        auto power = p.first.begin();
+        auto i2 = base_dict.begin();
+        map_basic_basic m;
+        RCP<const Number> overall_coeff = one;
+        for (; power != p.first.end(); ++power, ++i2) {
+            if (*power > 0) {
+                RCP<const Integer> exp = integer(*power);
+                RCP<const Basic> base = i2->first;
+                if (is_a<Integer>(*base)) {
+                    _imulnum(outArg(overall_coeff),
+                             rcp_static_cast<const Number>(
+                                 down_cast<const Integer &>(*base).powint(
+                                     *exp)));
+                } else if (is_a<Symbol>(*base)) {
+                    Mul::dict_add_term(m, exp, base);
+                } else {
+                    RCP<const Basic> exp2, t, tmp;
+                    tmp = pow(base, exp);
+                    if (is_a<Mul>(*tmp)) {
+                        for (auto &q :
+                             (down_cast<const Mul &>(*tmp)).get_dict()) {
+                            Mul::dict_add_term_new(outArg(overall_coeff), m,
+                                                   q.second, q.first);
                         }
-                    }
-                    if (!(i2->second->is_one())) {
                         _imulnum(outArg(overall_coeff),
-                                 pownum(i2->second,
-                                        rcp_static_cast<const Number>(exp)));
+                                 (down_cast<const Mul &>(*tmp)).get_coef());
+                    } else if (is_a_Number(*tmp)) {
+                        _imulnum(outArg(overall_coeff),
+                                 rcp_static_cast<const Number>(tmp));
+                    } else {
+                        Mul::as_base_exp(tmp, outArg(exp2), outArg(t));
+                        Mul::dict_add_term_new(outArg(overall_coeff), m,
+                                               exp2, t);
                     }
                 }
-            }
-            RCP<const Basic> term = Mul::from_dict(overall_coeff, std::move(d));
-            RCP<const Number> coef2 = integer(p.second);
-            if (is_a_Number(*term)) {
-                iaddnum(outArg(coeff),
-                        _mulnum(_mulnum(multiply,
-                                        rcp_static_cast<const Number>(term)),
-                                coef2));
-            } else {
-                if (is_a<Mul>(*term)
-                    && !(down_cast<const Mul &>(*term).get_coef()->is_one())) {
-                    // Tidy up things like {2x: 3} -> {x: 6}
-                    _imulnum(outArg(coef2),
-                             down_cast<const Mul &>(*term).get_coef());
-                    // We make a copy of the dict_:
-                    map_basic_basic d2
-                        = down_cast<const Mul &>(*term).get_dict();
-                    term = Mul::from_dict(one, std::move(d2));
+                if (!(i2->second->is_one())) {
+                    _imulnum(outArg(overall_coeff),
+                             pownum(i2->second,
+                                    rcp_static_cast<const Number>(exp)));
                 }
-                Add::dict_add_term(d_, _mulnum(multiply, coef2), term);
             }
         }
+        RCP<const Basic> term = Mul::from_dict(overall_coeff, std::move(m));
+        RCP<const Number> coef2 = integer(p.second);
+        if (is_a_Number(*term)) {
+            iaddnum(outArg(c),
+                    _mulnum(_mulnum(multiply,
+                                    rcp_static_cast<const Number>(term)),
+                            coef2));
+        } else {
+            if (is_a<Mul>(*term)
+                && !(down_cast<const Mul &>(*term).get_coef()->is_one())) {
+                // Tidy up things like {2x: 3} -> {x: 6}
+                _imulnum(outArg(coef2),
+                         down_cast<const Mul &>(*term).get_coef());
+                // We make a copy of the dict_:
+                map_basic_basic d2 = down_cast<const Mul &>(*term).get_dict();
+                term = Mul::from_dict(one, std::move(d2));
+            }
+            Add::dict_add_term(d, _mulnum(multiply, coef2), term);
+        }
     }
 
     void bvisit(const Pow &self)
@@ -358,7 +408,7 @@ private:
     RCP<const Basic> expand_if_deep(const RCP<const Basic> &expr)
     {
         if (deep) {
-            return expand(expr);
+            return expand(expr, true, nthreads);
         } else {
             return expr;
         }
@@ -366,9 +416,13 @@ private:
 };
 
 //! Expands `self`
-RCP<const Basic> expand(const RCP<const Basic> &self, bool deep)
+RCP<const Basic> expand(const RCP<const Basic> &self, bool deep,
+                        unsigned nthreads)
 {
-    ExpandVisitor v(deep);
+    RCP<const Basic> r;
+    if (deep and packed_expand(self, outArg(r), nthreads))
+        return r;
+    ExpandVisitor v(deep, nthreads);
     return v.apply(*self);
 }
 
@@ -178,6 +178,402 @@ void GaloisFieldDict::gf_istrip()
     }
 }
 
+// ---------------------------- Word-size kernels ----------------------------//
+// When the modulus is below 2^31 the coefficients are kept in machine words, so
+// that the product of two of them fits in 64 bits. Short products use the
+// schoolbook method with a lazily reduced accumulator, medium ones Karatsuba
+// and long ones a number theoretic transform over three word primes whose
+// images are recombined with Garner's algorithm. Division by long divisors
+// multiplies by the power series inverse of the reversed divisor, obtained by
+// Newton iteration.
+
+typedef std::vector<uint64_t> gf_word_poly;
+
+static const size_t gf_karatsuba_threshold = 32;
+static const size_t gf_ntt_threshold = 256;
+static const size_t gf_newton_threshold = 64;
+
+// Returns true and sets `p` if the modulus is small enough for the word kernels
+static bool gf_word_modulus(const integer_class &modulo, uint64_t &p)
+{
+    if (modulo < integer_class(2) or modulo >= integer_class(1UL << 31))
+        return false;
+    p = mp_get_ui(modulo);
+    return true;
+}
+
+static gf_word_poly gf_to_word(const std::vector<integer_class> &v,
+                               const integer_class &modulo)
+{
+    gf_word_poly r(v.size());
+    integer_class t;
+    for (size_t i = 0; i < v.size(); i++) {
+        if (v[i] < integer_class(0) or v[i] >= modulo) {
+            mp_fdiv_r(t, v[i], modulo);
+            r[i] = mp_get_ui(t);
+        } else {
+            r[i] = mp_get_ui(v[i]);
+        }
+    }
+    return r;
+}
+
+static std::vector<integer_class> gf_from_word(const uint64_t *v, size_t n)
+{
+    while (n > 0 and v[n - 1] == 0)
+        n--;
+    std::vector<integer_class> r(n);
+    for (size_t i = 0; i < n; i++)
+        r[i] = static_cast<unsigned long>(v[i]);
+    return r;
+}
+
+static uint64_t gf_powmod_word(uint64_t a, uint64_t e, uint64_t p)
+{
+    uint64_t r = 1;
+    a %= p;
+    while (e > 0) {
+        if (e & 1)
+            r = r * a % p;
+        a = a * a % p;
+        e >>= 1;
+    }
+    return r;
+}
+
+// c = a * b mod p, where `c` has room for na + nb - 1 coefficients. The
+// accumulator is kept below 2^63 by subtracting the largest multiple of `p`
+// not above 2^63 whenever it gets past it.
+static void gf_word_mul_basecase(const uint64_t *a, size_t na,
+                                 const uint64_t *b, size_t nb, uint64_t p,
+                                 uint64_t *c)
+{
+    const uint64_t half = uint64_t(1) << 63;
+    const uint64_t top = (half / p) * p;
+    for (size_t k = 0; k < na + nb - 1; k++) {
+        uint64_t acc = 0;
+        const size_t lo = k + 1 > nb ? k + 1 - nb : 0;
+        const size_t hi = std::min(k + 1, na);
+        for (size_t i = lo; i < hi; i++) {
+            acc += a[i] * b[k - i];
+            if (acc >= half)
+                acc -= top;
+        }
+        c[k] = acc % p;
+    }
+}
+
+static void gf_word_mul_karatsuba(const uint64_t *a, size_t na,
+                                  const uint64_t *b, size_t nb, uint64_t p,
+                                  uint64_t *c)
+{
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < gf_karatsuba_threshold) {
+        gf_word_mul_basecase(a, na, b, nb, p, c);
+        return;
+    }
+    const size_t m = (na + 1) / 2;
+    std::fill(c, c + na + nb - 1, 0);
+    if (nb <= m) {
+        // Unbalanced operands, only `a` is split
+        gf_word_poly t(m + nb - 1);
+        gf_word_mul_karatsuba(a, m, b, nb, p, c);
+        gf_word_mul_karatsuba(a + m, na - m, b, nb, p, &t[0]);
+        for (size_t i = 0; i < na - m + nb - 1; i++) {
+            c[i + m] += t[i];
+            if (c[i + m] >= p)
+                c[i + m] -= p;
+        }
+        return;
+    }
+    // a = a0 + x^m a1, b = b0 + x^m b1 and
+    // a b = z0 + x^m ((a0 + a1) (b0 + b1) - z0 - z2) + x^(2 m) z2
+    gf_word_poly s(m), t(m), z0(2 * m - 1), z1(2 * m - 1),
+        z2(na + nb - 2 * m - 1);
+    for (size_t i = 0; i < m; i++) {
+        s[i] = a[i] + (i < na - m ? a[i + m] : 0);
+        if (s[i] >= p)
+            s[i] -= p;
+        t[i] = b[i] + (i < nb - m ? b[i + m] : 0);
+        if (t[i] >= p)
+            t[i] -= p;
+    }
+    gf_word_mul_karatsuba(a, m, b, m, p, &z0[0]);
+    gf_word_mul_karatsuba(a + m, na - m, b + m, nb - m, p, &z2[0]);
+    gf_word_mul_karatsuba(&s[0], m, &t[0], m, p, &z1[0]);
+    for (size_t i = 0; i < z1.size(); i++) {
+        uint64_t v = z1[i] + 2 * p - z0[i] - (i < z2.size() ? z2[i] : 0);
+        c[i + m] = v % p;
+    }
+    for (size_t i = 0; i < z0.size(); i++) {
+        c[i] += z0[i];
+        if (c[i] >= p)
+            c[i] -= p;
+    }
+    for (size_t i = 0; i < z2.size(); i++) {
+        c[i + 2 * m] += z2[i];
+        if (c[i + 2 * m] >= p)
+            c[i + 2 * m] -= p;
+    }
+}
+
+// Montgomery arithmetic modulo an odd prime q < 2^30 with R = 2^32. Residues
+// are stored as x R mod q.
+class gf_montgomery
+{
+public:
+    uint32_t q_, qinv_, r2_;
+
+    gf_montgomery(uint32_t q) : q_(q)
+    {
+        // -q^-1 mod 2^32 by Newton iteration, each step doubles the bits
+        uint32_t inv = q;
+        for (int i = 0; i < 5; i++)
+            inv *= 2 - q * inv;
+        qinv_ = -inv;
+        uint64_t r = (uint64_t(1) << 32) % q;
+        r2_ = static_cast<uint32_t>(r * r % q);
+    }
+    uint32_t reduce(uint64_t t) const
+    {
+        const uint32_t m = static_cast<uint32_t>(t) * qinv_;
+        const uint32_t u = static_cast<uint32_t>((t + uint64_t(m) * q_) >> 32);
+        return u >= q_ ? u - q_ : u;
+    }
+    uint32_t mul(uint32_t a, uint32_t b) const
+    {
+        return reduce(uint64_t(a) * b);
+    }
+    uint32_t to(uint64_t a) const
+    {
+        return mul(static_cast<uint32_t>(a % q_), r2_);
+    }
+    uint32_t from(uint32_t a) const
+    {
+        return reduce(a);
+    }
+};
+
+// In-place transform of `a`, whose length is a power of two, with the powers
+// of the primitive root `g` of q. The inverse transform includes the scaling
+// by 1/n.
+static void gf_ntt(std::vector<uint32_t> &a, const gf_montgomery &M,
+                   uint32_t g, bool inverse)
+{
+    const size_t n = a.size();
+    const uint32_t q = M.q_;
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+    std::vector<uint32_t> w(n / 2);
+    for (size_t len = 2; len <= n; len <<= 1) {
+        uint64_t root = gf_powmod_word(g, (q - 1) / len, q);
+        if (inverse)
+            root = gf_powmod_word(root, q - 2, q);
+        const uint32_t wl = M.to(root);
+        const size_t h = len / 2;
+        w[0] = M.to(1);
+        for (size_t j = 1; j < h; j++)
+            w[j] = M.mul(w[j - 1], wl);
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < h; j++) {
+                const uint32_t u = a[i + j];
+                const uint32_t v = M.mul(a[i + j + h], w[j]);
+                a[i + j] = u + v >= q ? u + v - q : u + v;
+                a[i + j + h] = u >= v ? u - v : u + q - v;
+            }
+        }
+    }
+    if (inverse) {
+        const uint32_t ninv = M.to(gf_powmod_word(n % q, q - 2, q));
+        for (auto &x : a)
+            x = M.mul(x, ninv);
+    }
+}
+
+// Longest transform supported by all three primes below
+static const size_t gf_ntt_max_length = size_t(1) << 23;
+
+// Coefficients of a * b modulo q, for a prime q with primitive root g
+static std::vector<uint32_t> gf_ntt_mul(const uint64_t *a, size_t na,
+                                        const uint64_t *b, size_t nb,
+                                        uint32_t q, uint32_t g)
+{
+    const gf_montgomery M(q);
+    size_t n = 1;
+    while (n < na + nb - 1)
+        n <<= 1;
+    std::vector<uint32_t> fa(n, 0), fb(n, 0);
+    for (size_t i = 0; i < na; i++)
+        fa[i] = M.to(a[i]);
+    for (size_t i = 0; i < nb; i++)
+        fb[i] = M.to(b[i]);
+    gf_ntt(fa, M, g, false);
+    gf_ntt(fb, M, g, false);
+    for (size_t i = 0; i < n; i++)
+        fa[i] = M.mul(fa[i], fb[i]);
+    gf_ntt(fa, M, g, true);
+    fa.resize(na + nb - 1);
+    for (auto &x : fa)
+        x = M.from(x);
+    return fa;
+}
+
+// The coefficients of the exact product are below min(na, nb) p^2 < 2^85,
+// which is less than the product of the three primes, so they are determined
+// by their residues.
+static void gf_word_mul_ntt(const uint64_t *a, size_t na, const uint64_t *b,
+                            size_t nb, uint64_t p, uint64_t *c)
+{
+    const uint64_t q1 = 998244353, q2 = 167772161, q3 = 469762049;
+    const std::vector<uint32_t> r1 = gf_ntt_mul(a, na, b, nb, q1, 3);
+    const std::vector<uint32_t> r2 = gf_ntt_mul(a, na, b, nb, q2, 3);
+    const std::vector<uint32_t> r3 = gf_ntt_mul(a, na, b, nb, q3, 3);
+    const uint64_t q1_inv = gf_powmod_word(q1, q2 - 2, q2);
+    const uint64_t q12_inv = gf_powmod_word(q1 * q2 % q3, q3 - 2, q3);
+    const uint64_t q1_p = q1 % p, q12_p = q1 * q2 % p;
+    for (size_t i = 0; i < na + nb - 1; i++) {
+        // x = v1 + v2 q1 + v3 q1 q2
+        const uint64_t v1 = r1[i];
+        const uint64_t v2 = (r2[i] + q2 - v1 % q2) * q1_inv % q2;
+        const uint64_t x13 = (v1 + v2 * (q1 % q3)) % q3;
+        const uint64_t v3 = (r3[i] + q3 - x13) * q12_inv % q3;
+        c[i] = (v1 % p + v2 % p * q1_p % p + v3 % p * q12_p % p) % p;
+    }
+}
+
+static gf_word_poly gf_word_mul(const uint64_t *a, size_t na, const uint64_t *b,
+                                size_t nb, uint64_t p)
+{
+    if (na == 0 or nb == 0)
+        return gf_word_poly();
+    gf_word_poly c(na + nb - 1);
+    if (std::min(na, nb) >= gf_ntt_threshold
+        and na + nb - 1 <= gf_ntt_max_length)
+        gf_word_mul_ntt(a, na, b, nb, p, &c[0]);
+    else
+        gf_word_mul_karatsuba(a, na, b, nb, p, &c[0]);
+    return c;
+}
+
+// Inverse of the power series `f` modulo x^n, where f[0] is invertible
+static gf_word_poly gf_word_series_inverse(const gf_word_poly &f, size_t n,
+                                           uint64_t p, uint64_t f0_inv)
+{
+    gf_word_poly g(1, f0_inv);
+    size_t k = 1;
+    while (k < n) {
+        k = std::min(2 * k, n);
+        // g = g (2 - f g) mod x^k
+        gf_word_poly e
+            = gf_word_mul(&f[0], std::min(k, f.size()), &g[0], g.size(), p);
+        e.resize(k, 0);
+        for (auto &x : e)
+            x = x == 0 ? 0 : p - x;
+        e[0] = (e[0] + 2) % p;
+        g = gf_word_mul(&g[0], g.size(), &e[0], e.size(), p);
+        g.resize(k);
+    }
+    return g;
+}
+
+// Quotient and remainder of `a` by `b` modulo p, where `b` is stripped and
+// `lc_inv` is the inverse of its leading coefficient. `quo` or `rem` may be
+// null if that part is not needed.
+static void gf_word_divrem(const gf_word_poly &a, const gf_word_poly &b,
+                           uint64_t p, uint64_t lc_inv, gf_word_poly *quo,
+                           gf_word_poly *rem)
+{
+    const size_t na = a.size(), nb = b.size();
+    if (na < nb) {
+        if (quo)
+            quo->clear();
+        if (rem)
+            *rem = a;
+        return;
+    }
+    const size_t m = na - nb + 1;
+    if (m < gf_newton_threshold or nb < gf_newton_threshold) {
+        // Same scheme as gf_div, every coefficient of the output is the
+        // dividend's minus a dot product with the ones already computed
+        const uint64_t half = uint64_t(1) << 63;
+        const uint64_t top = (half / p) * p;
+        const size_t db = nb - 1;
+        gf_word_poly out(a);
+        gf_word_poly neg(db);
+        for (size_t j = 0; j < db; j++)
+            neg[j] = b[j] == 0 ? 0 : p - b[j];
+        const size_t stop = rem ? 0 : db;
+        for (size_t it = na; it-- > stop;) {
+            uint64_t acc = out[it];
+            const size_t lb = db + it > na - 1 ? db + it - (na - 1) : 0;
+            const size_t ub = std::min(it + 1, db);
+            for (size_t j = lb; j < ub; j++) {
+                acc += out[it - j + db] * neg[j];
+                if (acc >= half)
+                    acc -= top;
+            }
+            acc %= p;
+            if (it >= db)
+                acc = acc * lc_inv % p;
+            out[it] = acc;
+        }
+        if (quo)
+            quo->assign(out.begin() + db, out.end());
+        if (rem)
+            rem->assign(out.begin(), out.begin() + db);
+        return;
+    }
+    // rev(q) = rev(a) rev(b)^-1 mod x^m
+    gf_word_poly rb(b.rbegin(), b.rend());
+    if (rb.size() > m)
+        rb.resize(m);
+    const gf_word_poly g = gf_word_series_inverse(rb, m, p, lc_inv);
+    const gf_word_poly ra(a.rbegin(), a.rbegin() + m);
+    gf_word_poly q = gf_word_mul(&ra[0], m, &g[0], g.size(), p);
+    q.resize(m);
+    std::reverse(q.begin(), q.end());
+    if (rem) {
+        // Only the low nb - 1 coefficients of a - q b are needed
+        const size_t nr = nb - 1;
+        gf_word_poly qb = gf_word_mul(&q[0], std::min(m, nr), &b[0],
+                                      std::min(nb, nr), p);
+        rem->assign(a.begin(), a.begin() + nr);
+        for (size_t i = 0; i < nr and i < qb.size(); i++)
+            (*rem)[i] = (*rem)[i] >= qb[i] ? (*rem)[i] - qb[i]
+                                           : (*rem)[i] + p - qb[i];
+    }
+    if (quo)
+        quo->swap(q);
+}
+
+bool GaloisFieldDict::gf_div_word(const GaloisFieldDict &o,
+                                  std::vector<integer_class> *quo,
+                                  std::vector<integer_class> *rem) const
+{
+    uint64_t p;
+    if (not gf_word_modulus(modulo_, p))
+        return false;
+    integer_class inv;
+    mp_invert(inv, o.dict_.back(), modulo_);
+    gf_word_poly q, r;
+    gf_word_divrem(gf_to_word(dict_, modulo_), gf_to_word(o.dict_, modulo_),
+                   p, mp_get_ui(inv), quo ? &q : nullptr, rem ? &r : nullptr);
+    if (quo)
+        *quo = gf_from_word(q.data(), q.size());
+    if (rem)
+        *rem = gf_from_word(r.data(), r.size());
+    return true;
+}
+
 GaloisFieldDict GaloisFieldDict::mul(const GaloisFieldDict &a,
                                      const GaloisFieldDict &b)
 {
@@ -189,8 +585,17 @@ GaloisFieldDict GaloisFieldDict::mul(const GaloisFieldDict &a,
         return b;
 
     GaloisFieldDict p;
-    p.dict_.resize(a.degree() + b.degree() + 1, integer_class(0));
     p.modulo_ = a.modulo_;
+    uint64_t m;
+    if (gf_word_modulus(a.modulo_, m)) {
+        const gf_word_poly wa = gf_to_word(a.dict_, a.modulo_);
+        const gf_word_poly wb = gf_to_word(b.dict_, b.modulo_);
+        const gf_word_poly c
+            = gf_word_mul(&wa[0], wa.size(), &wb[0], wb.size(), m);
+        p.dict_ = gf_from_word(c.data(), c.size());
+        return p;
+    }
+    p.dict_.resize(a.degree() + b.degree() + 1, integer_class(0));
     for (unsigned int i = 0; i <= a.degree(); i++)
         for (unsigned int j = 0; j <= b.degree(); j++) {
             auto temp = a.dict_[i];
@@ -220,6 +625,12 @@ void GaloisFieldDict::gf_div(const GaloisFieldDict &o,
         *rem = GaloisFieldDict::from_vec(dict_, modulo_);
         return;
     }
+    std::vector<integer_class> word_quo, word_rem;
+    if (gf_div_word(o, &word_quo, &word_rem)) {
+        *quo = GaloisFieldDict::from_vec(word_quo, modulo_);
+        *rem = GaloisFieldDict::from_vec(word_rem, modulo_);
+        return;
+    }
     auto dict_divisor = o.dict_;
     auto deg_dividend = this->degree();
     auto deg_divisor = o.degree();
@@ -395,15 +806,125 @@ integer_class GaloisFieldDict::gf_eval(const integer_class &a) const
     return res;
 }
 
+// ------------------------- Subproduct tree algorithms ----------------------//
+// The points are split into blocks of `gf_subproduct_block` consecutive ones.
+// Level 0 of the tree holds the product of (x - v_i) over each block, and
+// every following level the products of pairs of nodes of the previous one,
+// an odd node being carried over as it is. The last level is the product of
+// (x - v_i) over all the points. Within a block the naive algorithms are used,
+// so for a single block this reduces to Horner's scheme and Lagrange's formula.
+
+static const size_t gf_subproduct_block = 32;
+
+static std::vector<std::vector<GaloisFieldDict>>
+gf_subproduct_tree(const vec_integer_class &v, const integer_class &modulo)
+{
+    std::vector<std::vector<GaloisFieldDict>> tree(1);
+    for (size_t i = 0; i < v.size(); i += gf_subproduct_block) {
+        GaloisFieldDict m(1, modulo);
+        const size_t end = std::min(i + gf_subproduct_block, v.size());
+        for (size_t j = i; j < end; j++)
+            m *= GaloisFieldDict::from_vec({-v[j], integer_class(1)}, modulo);
+        tree[0].push_back(std::move(m));
+    }
+    while (tree.back().size() > 1) {
+        const std::vector<GaloisFieldDict> &prev = tree.back();
+        std::vector<GaloisFieldDict> next;
+        for (size_t k = 0; k + 1 < prev.size(); k += 2)
+            next.push_back(prev[k] * prev[k + 1]);
+        if (prev.size() % 2 == 1)
+            next.push_back(prev.back());
+        tree.push_back(std::move(next));
+    }
+    return tree;
+}
+
+// Remainders of `f` modulo the nodes of level 0 of `tree`
+static std::vector<GaloisFieldDict>
+gf_subproduct_rem(const GaloisFieldDict &f,
+                  const std::vector<std::vector<GaloisFieldDict>> &tree)
+{
+    std::vector<GaloisFieldDict> rem = {f % tree.back()[0]};
+    for (size_t l = tree.size() - 1; l-- > 0;) {
+        std::vector<GaloisFieldDict> next(tree[l].size());
+        for (size_t k = 0; k < tree[l].size(); k++)
+            next[k] = rem[k / 2] % tree[l][k];
+        rem.swap(next);
+    }
+    return rem;
+}
+
 vec_integer_class
 GaloisFieldDict::gf_multi_eval(const vec_integer_class &v) const
 {
-    vec_integer_class res(v.size());
+    vec_integer_class res(v.size()), w(v.size());
     for (unsigned int i = 0; i < v.size(); ++i)
-        res[i] = gf_eval(v[i]);
+        mp_fdiv_r(w[i], v[i], modulo_);
+    if (v.size() <= gf_subproduct_block
+        or dict_.size() <= gf_subproduct_block) {
+        for (unsigned int i = 0; i < v.size(); ++i)
+            res[i] = gf_eval(w[i]);
+        return res;
+    }
+    const std::vector<GaloisFieldDict> rem
+        = gf_subproduct_rem(*this, gf_subproduct_tree(w, modulo_));
+    for (unsigned int i = 0; i < v.size(); ++i)
+        res[i] = rem[i / gf_subproduct_block].gf_eval(w[i]);
     return res;
 }
 
+GaloisFieldDict GaloisFieldDict::gf_interpolate(const vec_integer_class &x,
+                                                const vec_integer_class &y,
+                                                const integer_class &modulo)
+{
+    if (x.size() != y.size())
+        throw SymEngineException(
+            "gf_interpolate: number of points and values must agree");
+    if (x.empty())
+        return GaloisFieldDict::from_vec({}, modulo);
+    vec_integer_class w(x.size());
+    for (size_t i = 0; i < x.size(); i++)
+        mp_fdiv_r(w[i], x[i], modulo);
+    const std::vector<std::vector<GaloisFieldDict>> tree
+        = gf_subproduct_tree(w, modulo);
+
+    // Lagrange's formula, f = sum_i y_i / M'(x_i) M / (x - x_i) where M is the
+    // product of all (x - x_i)
+    const std::vector<GaloisFieldDict> dm
+        = gf_subproduct_rem(tree.back()[0].gf_diff(), tree);
+    std::vector<GaloisFieldDict> node(tree[0].size());
+    integer_class c;
+    for (size_t k = 0; k < tree[0].size(); k++) {
+        node[k] = GaloisFieldDict::from_vec({}, modulo);
+        const size_t end = std::min((k + 1) * gf_subproduct_block, x.size());
+        for (size_t i = k * gf_subproduct_block; i < end; i++) {
+            if (not mp_invert(c, dm[k].gf_eval(w[i]), modulo))
+                throw SymEngineException("gf_interpolate: points must be "
+                                         "distinct modulo the modulus");
+            GaloisFieldDict t = tree[0][k]
+                                / GaloisFieldDict::from_vec(
+                                    {-w[i], integer_class(1)}, modulo);
+            c *= y[i];
+            t *= c;
+            node[k] += t;
+        }
+    }
+    // and going up the tree, f_{l+1, k} = f_{l, 2k} M_{l, 2k+1}
+    //                                    + f_{l, 2k+1} M_{l, 2k}
+    for (size_t l = 0; l + 1 < tree.size(); l++) {
+        std::vector<GaloisFieldDict> next(tree[l + 1].size());
+        for (size_t k = 0; k < next.size(); k++) {
+            if (2 * k + 1 < tree[l].size())
+                next[k] = node[2 * k] * tree[l][2 * k + 1]
+                          + node[2 * k + 1] * tree[l][2 * k];
+            else
+                next[k] = node[2 * k];
+        }
+        node.swap(next);
+    }
+    return node[0];
+}
+
 bool GaloisFieldDict::gf_is_sqf() const
 {
     if (dict_.empty())
@@ -55,6 +55,11 @@ public:
     GaloisFieldDict &operator=(const GaloisFieldDict &) = default;
     void gf_div(const GaloisFieldDict &o, const Ptr<GaloisFieldDict> &quo,
                 const Ptr<GaloisFieldDict> &rem) const;
+    //! Division with the word-size kernels, returns false without touching
+    //! `quo` and `rem` if the modulus does not fit. Either of them may be
+    //! null if that part of the result is not needed.
+    bool gf_div_word(const GaloisFieldDict &o, std::vector<integer_class> *quo,
+                     std::vector<integer_class> *rem) const;
 
     GaloisFieldDict gf_lshift(const integer_class n) const;
     void gf_rshift(const integer_class n, const Ptr<GaloisFieldDict> &quo,
@@ -66,7 +71,14 @@ public:
     GaloisFieldDict gf_lcm(const GaloisFieldDict &o) const;
     GaloisFieldDict gf_diff() const;
     integer_class gf_eval(const integer_class &a) const;
+    //! Values at the points of `v`, found by reducing modulo a subproduct
+    //! tree over the points when there are many of them
     vec_integer_class gf_multi_eval(const vec_integer_class &v) const;
+    //! Polynomial of degree less than the number of points taking the values
+    //! `y` at the points `x`, which must be distinct modulo a prime `modulo`
+    static GaloisFieldDict gf_interpolate(const vec_integer_class &x,
+                                          const vec_integer_class &y,
+                                          const integer_class &modulo);
 
     // Returns whether polynomial is squarefield in `modulo_`
     bool gf_is_sqf() const;
@@ -393,6 +405,10 @@ public:
             return down_cast<GaloisFieldDict &>(*this);
         }
         std::vector<integer_class> dict_out;
+        if (gf_div_word(other, &dict_out, nullptr)) {
+            dict_.swap(dict_out);
+            return down_cast<GaloisFieldDict &>(*this);
+        }
         size_t deg_dividend = this->degree();
         size_t deg_divisor = other.degree();
         if (deg_dividend < deg_divisor) {
@@ -458,6 +474,10 @@ public:
             return down_cast<GaloisFieldDict &>(*this);
         }
         std::vector<integer_class> dict_out;
+        if (gf_div_word(other, nullptr, &dict_out)) {
+            dict_.swap(dict_out);
+            return down_cast<GaloisFieldDict &>(*this);
+        }
         size_t deg_dividend = this->degree();
         size_t deg_divisor = other.degree();
         if (deg_dividend < deg_divisor) {
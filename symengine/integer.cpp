@@ -6,6 +6,26 @@
 namespace SymEngine
 {
 
+#if SYMENGINE_SMALL_INTEGER_CACHE > 0
+const RCP<const Integer> &small_integer(long i)
+{
+    SYMENGINE_ASSERT(i >= -SYMENGINE_SMALL_INTEGER_CACHE
+                     and i <= SYMENGINE_SMALL_INTEGER_CACHE)
+    // Function local static, so that the cache is ready when integer() is
+    // called during the static initialization of the constants.
+    static const std::vector<RCP<const Integer>> cache = []() {
+        std::vector<RCP<const Integer>> v;
+        v.reserve(2 * SYMENGINE_SMALL_INTEGER_CACHE + 1);
+        for (long j = -SYMENGINE_SMALL_INTEGER_CACHE;
+             j <= SYMENGINE_SMALL_INTEGER_CACHE; j++) {
+            v.push_back(make_rcp<const Integer>(integer_class(j)));
+        }
+        return v;
+    }();
+    return cache[static_cast<size_t>(i + SYMENGINE_SMALL_INTEGER_CACHE)];
+}
+#endif
+
 hash_t Integer::__hash__() const
 {
     // only the least significant bits that fit into "long long int" are
@@ -10,6 +10,7 @@
 #include <symengine/number.h>
 #include <symengine/symengine_exception.h>
 #include <symengine/symengine_casts.h>
+#include <limits>
 
 namespace SymEngine
 {
@@ -80,20 +81,14 @@ public:
 
     /* These are very fast methods for add/sub/mul/div/pow on Integers only */
     //! Fast Integer Addition
-    inline RCP<const Integer> addint(const Integer &other) const
-    {
-        return make_rcp<const Integer>(this->i + other.i);
-    }
+    inline RCP<const Integer> addint(const Integer &other) const;
     //! Fast Integer Subtraction
     inline RCP<const Integer> subint(const Integer &other) const
     {
         return make_rcp<const Integer>(this->i - other.i);
     }
     //! Fast Integer Multiplication
-    inline RCP<const Integer> mulint(const Integer &other) const
-    {
-        return make_rcp<const Integer>(this->i * other.i);
-    }
+    inline RCP<const Integer> mulint(const Integer &other) const;
     //!  Integer Division
     RCP<const Number> divint(const Integer &other) const;
     //! Fast Negative Power Evaluation
@@ -190,21 +185,80 @@ struct RCPIntegerKeyLess {
         return a->as_integer_class() < b->as_integer_class();
     }
 };
+#if SYMENGINE_SMALL_INTEGER_CACHE > 0
+/*! Integers in the range [-SYMENGINE_SMALL_INTEGER_CACHE,
+    SYMENGINE_SMALL_INTEGER_CACHE] are preallocated and shared, so that the
+    coefficients created in the arithmetic hot paths do not allocate.
+    \return the shared instance of `i`, which must lie in that range
+*/
+const RCP<const Integer> &small_integer(long i);
+
+template <typename T>
+inline bool is_small_integer(T i, std::true_type /* is_signed */)
+{
+    return i >= -SYMENGINE_SMALL_INTEGER_CACHE
+           and i <= SYMENGINE_SMALL_INTEGER_CACHE;
+}
+
+template <typename T>
+inline bool is_small_integer(T i, std::false_type /* is_signed */)
+{
+    return i <= SYMENGINE_SMALL_INTEGER_CACHE;
+}
+#endif
+
 //! \return RCP<const Integer> from integral values
 template <typename T>
 inline typename std::enable_if<std::is_integral<T>::value,
                                RCP<const Integer>>::type
 integer(T i)
 {
+#if SYMENGINE_SMALL_INTEGER_CACHE > 0
+    if (is_small_integer(i, std::is_signed<T>()))
+        return small_integer(static_cast<long>(i));
+#endif
     return make_rcp<const Integer>(integer_class(i));
 }
 
 //! \return RCP<const Integer> from integer_class
 inline RCP<const Integer> integer(integer_class i)
 {
+#if SYMENGINE_SMALL_INTEGER_CACHE > 0
+    if (mp_fits_slong_p(i)) {
+        long l = mp_get_si(i);
+        if (is_small_integer(l, std::true_type()))
+            return small_integer(l);
+    }
+#endif
     return make_rcp<const Integer>(std::move(i));
 }
 
+// The sum and the product of two machine words are computed in machine words
+// when the operands are small enough that the result cannot overflow. Only
+// otherwise the arithmetic is done in `integer_class`.
+inline RCP<const Integer> Integer::addint(const Integer &other) const
+{
+    const long limit = std::numeric_limits<long>::max() / 2;
+    if (mp_fits_slong_p(this->i) and mp_fits_slong_p(other.i)) {
+        long a = mp_get_si(this->i), b = mp_get_si(other.i);
+        if (a <= limit and a >= -limit and b <= limit and b >= -limit)
+            return integer(a + b);
+    }
+    return integer(this->i + other.i);
+}
+
+inline RCP<const Integer> Integer::mulint(const Integer &other) const
+{
+    // 2**(half the bits of long - 1), so that |a*b| < 2**(bits - 2)
+    const long limit = 1L << (std::numeric_limits<long>::digits / 2 - 1);
+    if (mp_fits_slong_p(this->i) and mp_fits_slong_p(other.i)) {
+        long a = mp_get_si(this->i), b = mp_get_si(other.i);
+        if (a < limit and a > -limit and b < limit and b > -limit)
+            return integer(a * b);
+    }
+    return integer(this->i * other.i);
+}
+
 //! Integer Square root
 RCP<const Integer> isqrt(const Integer &n);
 //! Integer nth root
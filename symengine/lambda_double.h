@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <symengine/eval_double.h>
 #include <symengine/symengine_exception.h>
 #include <symengine/visitor.h>
@@ -32,6 +33,21 @@ protected:
     fn result_;
     vec_basic symbols;
 
+    /*
+       Closures for call_batch(). Each one evaluates its expression at up to
+       `batch_block` points, whose inputs are `x[i * stride + k]`, and writes
+       the values to `out[k]`. They are only built on the first call to
+       call_batch(), from `batch_inputs` and `batch_outputs`.
+    */
+    typedef std::function<void(T *out, const T *x, size_t stride, unsigned n)>
+        batch_fn;
+    static const unsigned batch_block = 64;
+    std::vector<batch_fn> batch_results;
+    std::vector<batch_fn> cse_batch_fns;
+    std::vector<T> cse_batch_results;
+    vec_basic batch_inputs, batch_outputs;
+    bool batch_cse = false;
+
 public:
     LambdaDoubleVisitor() = default;
     LambdaDoubleVisitor(LambdaDoubleVisitor &&) = default;
@@ -52,6 +68,11 @@ public:
     {
         results.clear();
         cse_intermediate_fns.clear();
+        batch_results.clear();
+        cse_batch_fns.clear();
+        batch_inputs = inputs;
+        batch_outputs = outputs;
+        batch_cse = cse;
         symbols = inputs;
         if (not cse) {
             for (auto &p : outputs) {
@@ -109,6 +130,245 @@ public:
         return;
     }
 
+    //! Evaluates the outputs at `n` points at once. The inputs are stored
+    //! one after another with `stride >= n` values each, so that `inps[j *
+    //! stride + k]` is the j-th input at the k-th point, and the i-th output
+    //! at the k-th point is written to `outs[i * stride + k]`. Arithmetic and
+    //! elementary functions are evaluated by loops over blocks of points,
+    //! instead of by one closure call per node and point as in call().
+    void call_batch(T *outs, const T *inps, size_t n, size_t stride)
+    {
+        if (batch_results.size() != results.size()) {
+            init_batch();
+        }
+        for (size_t b = 0; b < n; b += batch_block) {
+            unsigned m = static_cast<unsigned>(
+                n - b < batch_block ? n - b : batch_block);
+            for (unsigned i = 0; i < cse_batch_fns.size(); ++i) {
+                cse_batch_fns[i](&cse_batch_results[i * batch_block],
+                                 inps + b, stride, m);
+            }
+            for (unsigned i = 0; i < batch_results.size(); ++i) {
+                batch_results[i](outs + i * stride + b, inps + b, stride, m);
+            }
+        }
+    }
+
+protected:
+    void init_batch()
+    {
+        batch_results.clear();
+        cse_batch_fns.clear();
+        symbols = batch_inputs;
+        if (not batch_cse) {
+            for (auto &p : batch_outputs) {
+                batch_results.push_back(apply_batch(*p));
+            }
+        } else {
+            vec_basic reduced_exprs;
+            vec_pair replacements;
+            SymEngine::cse(replacements, reduced_exprs, batch_outputs);
+            // The closures keep pointers into these, so they must not be
+            // reallocated from now on
+            cse_intermediate_results.resize(replacements.size());
+            cse_batch_results.resize(replacements.size() * batch_block);
+            for (auto &rep : replacements) {
+                auto res = apply_batch(*(rep.second));
+                cse_intermediate_fns_map[rep.first] = cse_batch_fns.size();
+                cse_batch_fns.push_back(res);
+            }
+            for (unsigned i = 0; i < batch_outputs.size(); i++) {
+                batch_results.push_back(apply_batch(*reduced_exprs[i]));
+            }
+            cse_intermediate_fns_map.clear();
+            symbols.clear();
+        }
+    }
+
+    //! Scratch space for one batch closure. It is allocated once rather than
+    //! on the stack, which would overflow for deeply nested expressions.
+    static std::shared_ptr<std::vector<T>> batch_buffer()
+    {
+        return std::make_shared<std::vector<T>>(batch_block);
+    }
+
+    //! Value of an expression that does not depend on the inputs
+    T apply_constant(const Basic &b)
+    {
+        return apply(b)(nullptr);
+    }
+
+    //! Batch closure that applies `f` to the values of `arg`
+    template <typename F>
+    batch_fn apply_batch_unary(const Basic &arg, F f)
+    {
+        batch_fn a = apply_batch(arg);
+        return [=](T *out, const T *x, size_t stride, unsigned n) {
+            a(out, x, stride, n);
+            for (unsigned k = 0; k < n; ++k) {
+                out[k] = f(out[k]);
+            }
+        };
+    }
+
+    //! Batch closure for `base**exp`, computed with std::exp if `base` is E
+    //! and `use_exp` is true, as in bvisit(const Pow &)
+    batch_fn apply_batch_pow(const Basic &base, const Basic &exp,
+                             bool use_exp)
+    {
+        if (use_exp and eq(base, *E)) {
+            return apply_batch_unary(exp, [](T v) { return std::exp(v); });
+        }
+        if (is_a_Number(exp)) {
+            if (eq(exp, *one)) {
+                return apply_batch(base);
+            }
+            T e = apply_constant(exp);
+            return apply_batch_unary(base, [=](T v) { return std::pow(v, e); });
+        }
+        batch_fn b = apply_batch(base);
+        batch_fn e = apply_batch(exp);
+        auto buf = batch_buffer();
+        return [=](T *out, const T *x, size_t stride, unsigned n) {
+            T *t = buf->data();
+            b(out, x, stride, n);
+            e(t, x, stride, n);
+            for (unsigned k = 0; k < n; ++k) {
+                out[k] = std::pow(out[k], t[k]);
+            }
+        };
+    }
+
+    batch_fn apply_batch(const Basic &b)
+    {
+        switch (b.get_type_code()) {
+            case SYMENGINE_SYMBOL: {
+                for (unsigned i = 0; i < symbols.size(); ++i) {
+                    if (eq(b, *symbols[i])) {
+                        return [=](T *out, const T *x, size_t stride,
+                                   unsigned n) {
+                            const T *xi = x + i * stride;
+                            for (unsigned k = 0; k < n; ++k) {
+                                out[k] = xi[k];
+                            }
+                        };
+                    }
+                }
+                auto it = cse_intermediate_fns_map.find(b.rcp_from_this());
+                if (it != cse_intermediate_fns_map.end()) {
+                    const T *r = &cse_batch_results[it->second * batch_block];
+                    return [=](T *out, const T *x, size_t stride, unsigned n) {
+                        for (unsigned k = 0; k < n; ++k) {
+                            out[k] = r[k];
+                        }
+                    };
+                }
+                throw SymEngineException("Symbol not in the symbols vector.");
+            }
+            case SYMENGINE_ADD: {
+                const Add &a = down_cast<const Add &>(b);
+                T coef = apply_constant(*a.get_coef());
+                std::vector<std::pair<batch_fn, T>> terms;
+                for (const auto &p : a.get_dict()) {
+                    terms.push_back(std::make_pair(apply_batch(*p.first),
+                                                   apply_constant(*p.second)));
+                }
+                auto buf = batch_buffer();
+                return [=](T *out, const T *x, size_t stride, unsigned n) {
+                    T *t = buf->data();
+                    for (unsigned k = 0; k < n; ++k) {
+                        out[k] = coef;
+                    }
+                    for (const auto &p : terms) {
+                        p.first(t, x, stride, n);
+                        for (unsigned k = 0; k < n; ++k) {
+                            out[k] = out[k] + t[k] * p.second;
+                        }
+                    }
+                };
+            }
+            case SYMENGINE_MUL: {
+                const Mul &m = down_cast<const Mul &>(b);
+                T coef = apply_constant(*m.get_coef());
+                std::vector<batch_fn> factors;
+                for (const auto &p : m.get_dict()) {
+                    factors.push_back(
+                        apply_batch_pow(*p.first, *p.second, false));
+                }
+                auto buf = batch_buffer();
+                return [=](T *out, const T *x, size_t stride, unsigned n) {
+                    T *t = buf->data();
+                    for (unsigned k = 0; k < n; ++k) {
+                        out[k] = coef;
+                    }
+                    for (const auto &f : factors) {
+                        f(t, x, stride, n);
+                        for (unsigned k = 0; k < n; ++k) {
+                            out[k] = out[k] * t[k];
+                        }
+                    }
+                };
+            }
+            case SYMENGINE_POW: {
+                const Pow &p = down_cast<const Pow &>(b);
+                return apply_batch_pow(*p.get_base(), *p.get_exp(), true);
+            }
+            case SYMENGINE_SIN:
+                return apply_batch_unary(
+                    *down_cast<const OneArgFunction &>(b).get_arg(),
+                    [](T v) { return std::sin(v); });
+            case SYMENGINE_COS:
+                return apply_batch_unary(
+                    *down_cast<const OneArgFunction &>(b).get_arg(),
+                    [](T v) { return std::cos(v); });
+            case SYMENGINE_TAN:
+                return apply_batch_unary(
+                    *down_cast<const OneArgFunction &>(b).get_arg(),
+                    [](T v) { return std::tan(v); });
+            case SYMENGINE_LOG:
+                return apply_batch_unary(
+                    *down_cast<const OneArgFunction &>(b).get_arg(),
+                    [](T v) { return std::log(v); });
+            case SYMENGINE_ABS:
+                return apply_batch_unary(
+                    *down_cast<const OneArgFunction &>(b).get_arg(),
+                    [](T v) { return T(std::abs(v)); });
+            default:
+                break;
+        }
+        if (is_a_Number(b) or is_a<Constant>(b)) {
+            T value = apply_constant(b);
+            return [=](T *out, const T *x, size_t stride, unsigned n) {
+                for (unsigned k = 0; k < n; ++k) {
+                    out[k] = value;
+                }
+            };
+        }
+        // Anything else is evaluated point by point with the closure from
+        // apply(), after gathering the inputs and the intermediate values
+        // from common subexpressions it may refer to.
+        fn f = apply(b);
+        size_t n_inputs = symbols.size();
+        size_t n_cse = cse_batch_fns.size();
+        T *cse_result = cse_intermediate_results.data();
+        const T *cse_batch_result = cse_batch_results.data();
+        auto buf = std::make_shared<std::vector<T>>(n_inputs);
+        return [=](T *out, const T *x, size_t stride, unsigned n) {
+            T *xk = buf->data();
+            for (unsigned k = 0; k < n; ++k) {
+                for (size_t j = 0; j < n_inputs; ++j) {
+                    xk[j] = x[j * stride + k];
+                }
+                for (size_t j = 0; j < n_cse; ++j) {
+                    cse_result[j] = cse_batch_result[j * batch_block + k];
+                }
+                out[k] = f(xk);
+            }
+        };
+    }
+
+public:
+
     void bvisit(const Symbol &x)
     {
         for (unsigned i = 0; i < symbols.size(); ++i) {
@@ -363,6 +623,9 @@ public:
     };
 };
 
+template <typename T>
+const unsigned LambdaDoubleVisitor<T>::batch_block;
+
 class LambdaRealDoubleVisitor
     : public BaseVisitor<LambdaRealDoubleVisitor, LambdaDoubleVisitor<double>>
 {
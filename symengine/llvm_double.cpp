@@ -28,12 +28,36 @@
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/DynamicLibrary.h"
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Transforms/InstCombine/InstCombine.h"
+#include "llvm/Transforms/Scalar/SimplifyCFG.h"
+#include "llvm/Transforms/Vectorize/LoopVectorize.h"
+#include "llvm/Transforms/Vectorize/SLPVectorizer.h"
+#if (LLVM_VERSION_MAJOR >= 10)
+#include "llvm/Transforms/Utils/InjectTLIMappings.h"
+#endif
+#if (LLVM_VERSION_MAJOR < 17)
+#include "llvm/Support/Host.h"
+#else
+#include "llvm/TargetParser/Host.h"
+#endif
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdlib>
+#include <sstream>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <fstream>
 
+#include <symengine/symengine_config.h>
 #include <symengine/llvm_double.h>
 #include <symengine/eval_double.h>
 #include <symengine/eval.h>
@@ -66,9 +90,366 @@ llvm::Value *LLVMVisitor::apply(const Basic &b)
 }
 
 void LLVMVisitor::init(const vec_basic &x, const Basic &b, bool symbolic_cse,
-                       unsigned opt_level)
+                       unsigned opt_level, bool batch)
+{
+    init(x, {b.rcp_from_this()}, symbolic_cse, opt_level, batch);
+}
+
+namespace
+{
+// Target machine for the CPU we are running on, so that the loop vectorizer
+// picks the widest vector registers available (SSE, AVX2 or AVX-512)
+llvm::TargetMachine *get_host_target_machine(unsigned opt_level)
+{
+    std::vector<std::string> attrs;
+    llvm::StringMap<bool> features;
+    if (llvm::sys::getHostCPUFeatures(features)) {
+        for (auto &f : features) {
+            attrs.push_back((f.second ? "+" : "-") + f.first().str());
+        }
+    }
+    llvm::TargetMachine *target_machine
+        = llvm::EngineBuilder()
+              .setMCPU(llvm::sys::getHostCPUName())
+              .setMAttrs(attrs)
+              .setOptLevel(static_cast<CodeGenOptLevel>(opt_level))
+              .selectTarget();
+    if (target_machine == nullptr) {
+        throw SymEngineException("Cannot create a target for the host CPU");
+    }
+    return target_machine;
+}
+
+std::string &llvm_cache_directory()
+{
+    static std::string path = []() {
+        const char *env = std::getenv("SYMENGINE_LLVM_CACHE_DIR");
+        return std::string(env == nullptr ? "" : env);
+    }();
+    return path;
+}
+
+// Version of the code generated by `codegen` and `optimize`. It must be bumped
+// whenever their output changes, as SYMENGINE_VERSION only changes on release.
+const unsigned llvm_codegen_version = 1;
+
+// Everything the compiled object code depends on. The expressions are
+// serialized, so that the key does not depend on how they are printed.
+std::string get_cache_key(const vec_basic &inputs, const vec_basic &outputs,
+                          const std::string &float_type, bool symbolic_cse,
+                          unsigned opt_level, bool batch, size_t nchunks)
+{
+    std::ostringstream key;
+    key << "SymEngine " << SYMENGINE_VERSION << " codegen "
+        << llvm_codegen_version << " ";
+    key << "LLVM " << LLVM_VERSION_MAJOR << "." << LLVM_VERSION_MINOR << " "
+        << llvm::sys::getProcessTriple() << " " << float_type << " "
+        << symbolic_cse << " " << opt_level << " " << batch << " " << nchunks;
+    if (batch) {
+        // The loop is compiled for the features of this particular CPU
+        llvm::StringMap<bool> features;
+        key << " " << llvm::sys::getHostCPUName().str();
+        if (llvm::sys::getHostCPUFeatures(features)) {
+            std::vector<std::string> names;
+            for (auto &f : features) {
+                if (f.second) {
+                    names.push_back(f.first().str());
+                }
+            }
+            std::sort(names.begin(), names.end());
+            for (auto &name : names) {
+                key << " " << name;
+            }
+        }
+    }
+    for (const vec_basic *v : {&inputs, &outputs}) {
+        key << "\n" << v->size();
+        for (auto &e : *v) {
+            std::string data = e->dumps();
+            key << "\n" << data.size() << " " << data;
+        }
+    }
+    return key.str();
+}
+
+std::string get_cache_path(const std::string &key)
+{
+    auto hash = llvm::SHA1::hash(llvm::ArrayRef<uint8_t>(
+        reinterpret_cast<const uint8_t *>(key.data()), key.size()));
+    std::string name;
+    const char *digits = "0123456789abcdef";
+    for (uint8_t c : hash) {
+        name.push_back(digits[c >> 4]);
+        name.push_back(digits[c & 15]);
+    }
+    llvm::SmallString<128> path(llvm_cache_directory());
+    llvm::sys::path::append(path, name + ".o");
+    return path.str().str();
+}
+
+// A cache entry is the size of the key, the key and then the object code.
+// The key is stored in full to guard against collisions of the hash.
+bool read_cache_entry(const std::string &path, const std::string &key,
+                      std::string &object)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (not buffer) {
+        return false;
+    }
+    llvm::StringRef data = (*buffer)->getBuffer();
+    std::string header = std::to_string(key.size()) + "\n";
+    if (not data.startswith(header)) {
+        return false;
+    }
+    data = data.drop_front(header.size());
+    if (not data.startswith(key)) {
+        return false;
+    }
+    object = data.drop_front(key.size()).str();
+    return not object.empty();
+}
+
+// Errors are ignored, as the cache is only an optimization. The entry is
+// written to a temporary file first, so that concurrent readers never see a
+// partially written entry.
+void write_cache_entry(const std::string &path, const std::string &key,
+                       const std::string &object)
+{
+    if (llvm::sys::fs::create_directories(llvm_cache_directory())) {
+        return;
+    }
+    int fd;
+    llvm::SmallString<128> tmp_path;
+    if (llvm::sys::fs::createUniqueFile(path + ".%%%%%%.tmp", fd, tmp_path)) {
+        return;
+    }
+    {
+        llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+        os << key.size() << "\n" << key << object;
+        os.close();
+        if (os.has_error()) {
+            os.clear_error();
+            llvm::sys::fs::remove(tmp_path);
+            return;
+        }
+    }
+    if (llvm::sys::fs::rename(tmp_path, path)) {
+        llvm::sys::fs::remove(tmp_path);
+    }
+}
+
+#if (LLVM_VERSION_MAJOR >= 13)
+// Vectorized versions of sin, cos, exp, log and pow from glibc, if present
+bool have_vector_math_library()
+{
+#if defined(__linux__) && defined(__x86_64__)
+    static const bool loaded
+        = not llvm::sys::DynamicLibrary::LoadLibraryPermanently("libmvec.so.1");
+    return loaded;
+#else
+    return false;
+#endif
+}
+#endif
+// Add the extra attributes for the loop over many points
+void set_preferred_vector_width(llvm::Function *BF,
+                                llvm::TargetMachine &target_machine)
+{
+    if (target_machine.getTargetFeatureString().find("+avx512f")
+        != llvm::StringRef::npos) {
+        // LLVM defaults to 256-bit vectors even if AVX-512 is available
+        BF->addFnAttr("prefer-vector-width", "512");
+    }
+}
+
+// Optimize the function using default passes from PassBuilder
+// FunctionSimplificationPipeline for the opt_level. The loop over many points
+// `BF` is also vectorized for `target_machine`.
+void optimize(llvm::Function *F, llvm::Function *BF, unsigned opt_level,
+              llvm::TargetMachine *target_machine)
+{
+#if (LLVM_VERSION_MAJOR < 14)
+    using OptimizationLevel = llvm::PassBuilder::OptimizationLevel;
+#else
+    using OptimizationLevel = llvm::OptimizationLevel;
+#endif
+    llvm::PassBuilder PB;
+    // The proxies between the managers require them to be destroyed in the
+    // reverse order: the function analyses still refer to the loop ones.
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+    if (BF != nullptr) {
+        // The cost model of the vectorizer needs the host target and the
+        // vector math functions it may call. These have to be registered
+        // before the default analyses.
+        llvm::TargetLibraryInfoImpl tlii(target_machine->getTargetTriple());
+#if (LLVM_VERSION_MAJOR >= 13)
+        if (have_vector_math_library()) {
+            tlii.addVectorizableFunctionsFromVecLib(
+                llvm::TargetLibraryInfoImpl::LIBMVEC_X86);
+        }
+#endif
+        FAM.registerPass([tlii] { return llvm::TargetLibraryAnalysis(tlii); });
+        FAM.registerPass([&] { return target_machine->getTargetIRAnalysis(); });
+    }
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    llvm::FunctionPassManager FPM;
+    OptimizationLevel pb_opt_level{OptimizationLevel::O3};
+    if (opt_level == 0) {
+        pb_opt_level = OptimizationLevel::O0;
+    } else if (opt_level == 1) {
+        pb_opt_level = OptimizationLevel::O1;
+    } else if (opt_level == 2) {
+        pb_opt_level = OptimizationLevel::O2;
+    }
+#if (LLVM_VERSION_MAJOR < 6)
+    FPM = PB.buildFunctionSimplificationPipeline(pb_opt_level);
+#elif (LLVM_VERSION_MAJOR < 12)
+    FPM = PB.buildFunctionSimplificationPipeline(
+        pb_opt_level, llvm::PassBuilder::ThinLTOPhase::None);
+#else
+    FPM = PB.buildFunctionSimplificationPipeline(
+        pb_opt_level, llvm::ThinOrFullLTOPhase::None);
+#endif
+    FPM.run(*F, FAM);
+
+    if (BF != nullptr) {
+#if (LLVM_VERSION_MAJOR < 6)
+        FPM = PB.buildFunctionSimplificationPipeline(pb_opt_level);
+#elif (LLVM_VERSION_MAJOR < 12)
+        FPM = PB.buildFunctionSimplificationPipeline(
+            pb_opt_level, llvm::PassBuilder::ThinLTOPhase::None);
+#else
+        FPM = PB.buildFunctionSimplificationPipeline(
+            pb_opt_level, llvm::ThinOrFullLTOPhase::None);
+#endif
+        if (opt_level > 1) {
+#if (LLVM_VERSION_MAJOR >= 10)
+            FPM.addPass(llvm::InjectTLIMappings());
+#endif
+            FPM.addPass(llvm::LoopVectorizePass());
+            FPM.addPass(llvm::SLPVectorizerPass());
+            FPM.addPass(llvm::InstCombinePass());
+            FPM.addPass(llvm::SimplifyCFGPass());
+        }
+        FPM.run(*BF, FAM);
+    }
+}
+
+std::unique_ptr<llvm::ExecutionEngine>
+create_engine(std::unique_ptr<llvm::Module> module, unsigned opt_level,
+              std::unique_ptr<llvm::TargetMachine> target_machine)
 {
-    init(x, {b.rcp_from_this()}, symbolic_cse, opt_level);
+    std::string error;
+    llvm::EngineBuilder engine_builder(std::move(module));
+    engine_builder.setEngineKind(llvm::EngineKind::Kind::JIT)
+        .setOptLevel(static_cast<CodeGenOptLevel>(opt_level))
+        .setErrorStr(&error);
+    if (target_machine) {
+        // Generate code for the same CPU the vectorizer was tuned for
+        return std::unique_ptr<llvm::ExecutionEngine>(
+            engine_builder.create(target_machine.release()));
+    }
+    return std::unique_ptr<llvm::ExecutionEngine>(engine_builder.create());
+}
+
+// This is a hack to get the MemoryBuffer of a compiled object.
+class MemoryBufferRefCallback : public llvm::ObjectCache
+{
+public:
+    std::string &ss_;
+    MemoryBufferRefCallback(std::string &ss) : ss_(ss) {}
+
+    void notifyObjectCompiled(const llvm::Module *M,
+                              llvm::MemoryBufferRef obj) override
+    {
+        const char *c = obj.getBufferStart();
+        // Saving the object code in a std::string
+        ss_.assign(c, obj.getBufferSize());
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer>
+    getObject(const llvm::Module *M) override
+    {
+        return NULL;
+    }
+};
+
+// Objects of outputs compiled in chunks are saved together, starting with
+// the one containing the entry points. A single object is saved as is.
+const std::string chunks_magic = "SymEngine LLVM chunks\n";
+
+std::string pack_objects(const std::vector<std::string> &objects)
+{
+    std::string s = chunks_magic + std::to_string(objects.size()) + "\n";
+    for (auto &object : objects) {
+        s += std::to_string(object.size()) + "\n";
+    }
+    for (auto &object : objects) {
+        s += object;
+    }
+    return s;
+}
+
+bool unpack_objects(const std::string &s, std::vector<std::string> &objects)
+{
+    if (s.compare(0, chunks_magic.size(), chunks_magic) != 0) {
+        return false;
+    }
+    std::istringstream is(s.substr(chunks_magic.size()));
+    size_t n = 0, size;
+    std::vector<size_t> sizes;
+    is >> n;
+    while (is and sizes.size() < n and is >> size) {
+        sizes.push_back(size);
+    }
+    if (n == 0 or sizes.size() != n or is.get() != '\n') {
+        throw SymEngineException("Invalid serialized LLVM object code");
+    }
+    size_t pos = chunks_magic.size() + static_cast<size_t>(is.tellg());
+    for (size_t i = 0; i < n; i++) {
+        if (sizes[i] > s.size() - pos) {
+            throw SymEngineException("Invalid serialized LLVM object code");
+        }
+        objects.push_back(s.substr(pos, sizes[i]));
+        pos += sizes[i];
+    }
+    return true;
+}
+
+// Load already compiled objects into `engine` before it is finalized
+void add_objects(llvm::ExecutionEngine &engine,
+                 const std::vector<std::string> &objects)
+{
+    for (auto &object : objects) {
+        auto buffer = llvm::MemoryBuffer::getMemBufferCopy(object);
+        auto obj = llvm::object::ObjectFile::createObjectFile(
+            buffer->getMemBufferRef());
+        if (not obj) {
+            llvm::consumeError(obj.takeError());
+            throw SymEngineException("Invalid LLVM object code");
+        }
+        engine.addObjectFile(
+            llvm::object::OwningBinary<llvm::object::ObjectFile>(
+                std::move(*obj), std::move(buffer)));
+    }
+}
+} // namespace
+
+void set_llvm_cache_directory(const std::string &path)
+{
+    llvm_cache_directory() = path;
+}
+
+const std::string &get_llvm_cache_directory()
+{
+    return llvm_cache_directory();
 }
 
 llvm::Function *LLVMVisitor::get_function_type(llvm::LLVMContext *context)
@@ -127,28 +508,62 @@ llvm::Function *LLVMVisitor::get_function_type(llvm::LLVMContext *context)
     return F;
 }
 
-void LLVMVisitor::init(const vec_basic &inputs, const vec_basic &outputs,
-                       const bool symbolic_cse, unsigned opt_level)
+llvm::Function *LLVMVisitor::get_batch_function_type(llvm::LLVMContext *context)
 {
-    executionengine.reset();
-    llvm::InitializeNativeTarget();
-    llvm::InitializeNativeTargetAsmPrinter();
-    llvm::InitializeNativeTargetAsmParser();
-    context = make_unique<llvm::LLVMContext>();
-    symbols = inputs;
+    std::vector<llvm::Type *> inp;
+    for (int i = 0; i < 2; i++) {
+        inp.push_back(llvm::PointerType::get(get_float_type(context), 0));
+    }
+    inp.push_back(llvm::Type::getIntNTy(*context, 8 * sizeof(size_t)));
+    llvm::FunctionType *function_type = llvm::FunctionType::get(
+        llvm::Type::getVoidTy(*context), inp, /*isVarArgs=*/false);
+    auto F = llvm::Function::Create(
+        function_type, llvm::Function::InternalLinkage, "batch", mod);
+    F->setCallingConv(llvm::CallingConv::C);
+    // Inputs and outputs may not overlap, which saves the vectorizer from
+    // emitting runtime alias checks
+    F->addParamAttr(0, llvm::Attribute::ReadOnly);
+    F->addParamAttr(0, llvm::Attribute::NoCapture);
+    F->addParamAttr(0, llvm::Attribute::NoAlias);
+    F->addParamAttr(1, llvm::Attribute::NoCapture);
+    F->addParamAttr(1, llvm::Attribute::NoAlias);
+    F->addFnAttr(llvm::Attribute::NoUnwind);
+    return F;
+}
 
-    // Create some module to put our function into it.
-    std::unique_ptr<llvm::Module> module
-        = make_unique<llvm::Module>("SymEngine", *context.get());
-    module->setDataLayout("");
-    mod = module.get();
+void LLVMVisitor::codegen(llvm::Function *F, llvm::Function *BF,
+                          const vec_basic &outputs, bool symbolic_cse)
+{
+    llvm::LLVMContext &ctx = mod->getContext();
+    llvm::Type *float_type = get_float_type(&ctx);
 
-    auto F = get_function_type(context.get());
+    vec_pair replacements;
+    vec_basic reduced_exprs;
+    if (symbolic_cse) {
+        // cse the outputs
+        SymEngine::cse(replacements, reduced_exprs, outputs);
+    } else {
+        reduced_exprs = outputs;
+    }
+    // Generate IR for all the replacements and the reduced exprs at the
+    // current insert point and return references to the outputs
+    auto codegen_outputs = [&]() {
+        replacement_symbol_ptrs.clear();
+        for (auto &rep : replacements) {
+            // Store the replacement symbol values in a dictionary
+            replacement_symbol_ptrs[rep.first] = apply(*(rep.second));
+        }
+        std::vector<llvm::Value *> output_vals;
+        for (unsigned i = 0; i < outputs.size(); i++) {
+            output_vals.push_back(apply(*reduced_exprs[i]));
+        }
+        return output_vals;
+    };
 
     // Add a basic block to the function. As before, it automatically
     // inserts
     // because of the last argument.
-    llvm::BasicBlock *BB = llvm::BasicBlock::Create(*context, "EntryBlock", F);
+    llvm::BasicBlock *BB = llvm::BasicBlock::Create(ctx, "EntryBlock", F);
 
     // Create a basic block builder with default parameters.  The builder
     // will
@@ -161,16 +576,15 @@ void LLVMVisitor::init(const vec_basic &inputs, const vec_basic &outputs,
     builder->setFastMathFlags(fmf);
 
     // Load all the symbols and create references
+    symbol_ptrs.clear();
     auto input_arg = &(*(F->args().begin()));
-    for (unsigned i = 0; i < inputs.size(); i++) {
-        if (not is_a<Symbol>(*inputs[i])) {
+    for (unsigned i = 0; i < symbols.size(); i++) {
+        if (not is_a<Symbol>(*symbols[i])) {
             throw SymEngineException("Input contains a non-symbol.");
         }
-        auto index
-            = llvm::ConstantInt::get(llvm::Type::getInt32Ty(*context), i);
-        auto ptr = builder->CreateGEP(get_float_type(context.get()), input_arg,
-                                      index);
-        result_ = builder->CreateLoad(get_float_type(context.get()), ptr);
+        auto index = llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx), i);
+        auto ptr = builder->CreateGEP(float_type, input_arg, index);
+        result_ = builder->CreateLoad(float_type, ptr);
         symbol_ptrs.push_back(result_);
     }
 
@@ -180,34 +594,12 @@ void LLVMVisitor::init(const vec_basic &inputs, const vec_basic &outputs,
 #else
     auto out = &(*(it + 1));
 #endif
-    std::vector<llvm::Value *> output_vals;
-
-    if (symbolic_cse) {
-        vec_basic reduced_exprs;
-        vec_pair replacements;
-        // cse the outputs
-        SymEngine::cse(replacements, reduced_exprs, outputs);
-        for (auto &rep : replacements) {
-            // Store the replacement symbol values in a dictionary
-            replacement_symbol_ptrs[rep.first] = apply(*(rep.second));
-        }
-        // Generate IR for all the reduced exprs and save references
-        for (unsigned i = 0; i < outputs.size(); i++) {
-            output_vals.push_back(apply(*reduced_exprs[i]));
-        }
-    } else {
-        // Generate IR for all the output exprs and save references
-        for (unsigned i = 0; i < outputs.size(); i++) {
-            output_vals.push_back(apply(*outputs[i]));
-        }
-    }
+    std::vector<llvm::Value *> output_vals = codegen_outputs();
 
     // Store all the output exprs at the end
     for (unsigned i = 0; i < outputs.size(); i++) {
-        auto index
-            = llvm::ConstantInt::get(llvm::Type::getInt32Ty(*context), i);
-        auto ptr
-            = builder->CreateGEP(get_float_type(context.get()), out, index);
+        auto index = llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx), i);
+        auto ptr = builder->CreateGEP(float_type, out, index);
         builder->CreateStore(output_vals[i], ptr);
     }
 
@@ -217,93 +609,261 @@ void LLVMVisitor::init(const vec_basic &inputs, const vec_basic &outputs,
     // Validate the generated code, checking for consistency.
     llvm::verifyFunction(*F, &llvm::outs());
 
-    //     std::cout << "LLVM IR" << std::endl;
-    // #if (LLVM_VERSION_MAJOR < 5)
-    //     module->dump();
-    // #else
-    //     module->print(llvm::errs(), nullptr);
-    // #endif
+    if (BF == nullptr) {
+        return;
+    }
+    // Same expressions in a loop over the points `k = 0, ..., n - 1`
+    // where the input `i` is `inps[i*n+k]` and the output `j` is
+    // `outs[j*n+k]`, so that every access has unit stride.
+    auto args = BF->arg_begin();
+    llvm::Value *inps = &*args++;
+    llvm::Value *outs = &*args++;
+    llvm::Value *n = &*args;
+    llvm::Type *index_type = n->getType();
+
+    llvm::BasicBlock *entry_bb = llvm::BasicBlock::Create(ctx, "entry", BF);
+    llvm::BasicBlock *loop_bb = llvm::BasicBlock::Create(ctx, "loop", BF);
+    llvm::BasicBlock *exit_bb = llvm::BasicBlock::Create(ctx, "exit", BF);
+
+    builder->SetInsertPoint(entry_bb);
+    std::vector<llvm::Value *> inp_rows, out_rows;
+    for (unsigned i = 0; i < symbols.size(); i++) {
+        auto offset = builder->CreateMul(
+            n, llvm::ConstantInt::get(index_type, i), "", true, true);
+        inp_rows.push_back(builder->CreateGEP(float_type, inps, offset));
+    }
+    for (unsigned i = 0; i < outputs.size(); i++) {
+        auto offset = builder->CreateMul(
+            n, llvm::ConstantInt::get(index_type, i), "", true, true);
+        out_rows.push_back(builder->CreateGEP(float_type, outs, offset));
+    }
+    auto zero_index = llvm::ConstantInt::get(index_type, 0);
+    builder->CreateCondBr(builder->CreateICmpEQ(n, zero_index), exit_bb,
+                          loop_bb);
 
-    // module->print(llvm::errs(), nullptr);
+    builder->SetInsertPoint(loop_bb);
+    llvm::PHINode *k = builder->CreatePHI(index_type, 2, "k");
+    k->addIncoming(zero_index, entry_bb);
+    symbol_ptrs.clear();
+    for (unsigned i = 0; i < symbols.size(); i++) {
+        auto ptr = builder->CreateGEP(float_type, inp_rows[i], k);
+        symbol_ptrs.push_back(builder->CreateLoad(float_type, ptr));
+    }
+    output_vals = codegen_outputs();
+    for (unsigned i = 0; i < outputs.size(); i++) {
+        auto ptr = builder->CreateGEP(float_type, out_rows[i], k);
+        builder->CreateStore(output_vals[i], ptr);
+    }
+    // Piecewise may have added blocks, the loop continues from the last
+    auto next = builder->CreateAdd(k, llvm::ConstantInt::get(index_type, 1),
+                                   "", true, true);
+    k->addIncoming(next, builder->GetInsertBlock());
+    builder->CreateCondBr(builder->CreateICmpEQ(next, n), exit_bb, loop_bb);
 
-    // Optimize the function using default passes from PassBuilder
-    // FunctionSimplificationPipeline for the opt_level
-#if (LLVM_VERSION_MAJOR < 14)
-    using OptimizationLevel = llvm::PassBuilder::OptimizationLevel;
-#else
-    using OptimizationLevel = llvm::OptimizationLevel;
-#endif
-    llvm::PassBuilder PB;
-    llvm::ModuleAnalysisManager MAM;
-    llvm::CGSCCAnalysisManager CGAM;
-    llvm::FunctionAnalysisManager FAM;
-    llvm::LoopAnalysisManager LAM;
-    PB.registerModuleAnalyses(MAM);
-    PB.registerCGSCCAnalyses(CGAM);
-    PB.registerFunctionAnalyses(FAM);
-    PB.registerLoopAnalyses(LAM);
-    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
-    llvm::FunctionPassManager FPM;
-    OptimizationLevel pb_opt_level{OptimizationLevel::O3};
-    if (opt_level == 0) {
-        pb_opt_level = OptimizationLevel::O0;
-    } else if (opt_level == 1) {
-        pb_opt_level = OptimizationLevel::O1;
-    } else if (opt_level == 2) {
-        pb_opt_level = OptimizationLevel::O2;
+    builder->SetInsertPoint(exit_bb);
+    builder->CreateRetVoid();
+    llvm::verifyFunction(*BF, &llvm::outs());
+}
+
+void LLVMVisitor::init(const vec_basic &inputs, const vec_basic &outputs,
+                       const bool symbolic_cse, unsigned opt_level,
+                       const bool batch, unsigned nthreads)
+{
+    executionengine.reset();
+    batch_func = 0;
+    pure_external_functions = batch;
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+    context = make_unique<llvm::LLVMContext>();
+
+    // Several chunks per thread, as the outputs vary in size
+    size_t nchunks = 1;
+    if (nthreads > 1) {
+        nchunks = std::min<size_t>(outputs.size(), 4 * nthreads);
+        nchunks = std::max<size_t>(nchunks, 1);
     }
-#if (LLVM_VERSION_MAJOR < 6)
-    FPM = PB.buildFunctionSimplificationPipeline(pb_opt_level);
-#elif (LLVM_VERSION_MAJOR < 12)
-    FPM = PB.buildFunctionSimplificationPipeline(
-        pb_opt_level, llvm::PassBuilder::ThinLTOPhase::None);
-#else
-    FPM = PB.buildFunctionSimplificationPipeline(
-        pb_opt_level, llvm::ThinOrFullLTOPhase::None);
-#endif
-    FPM.run(*F, FAM);
 
-    // std::cout << "Optimized LLVM IR" << std::endl;
-    // module->print(llvm::errs(), nullptr);
+    std::string cache_key, cache_path;
+    if (not llvm_cache_directory().empty()) {
+        std::string float_type;
+        llvm::raw_string_ostream os(float_type);
+        get_float_type(context.get())->print(os);
+        os.flush();
+        try {
+            cache_key = get_cache_key(inputs, outputs, float_type,
+                                      symbolic_cse, opt_level, batch, nchunks);
+            cache_path = get_cache_path(cache_key);
+        } catch (SymEngineException &) {
+            // Some expressions cannot be serialized, compile them every time
+        }
+        std::string object;
+        if (not cache_path.empty()
+            and read_cache_entry(cache_path, cache_key, object)) {
+            loads(object);
+            return;
+        }
+    }
+    symbols = inputs;
+    if (batch) {
+        // Load it before any thread might need it
+        have_vector_math_library();
+    }
 
-    // Now we create the JIT.
-    std::string error;
-    executionengine = std::unique_ptr<llvm::ExecutionEngine>(
-        llvm::EngineBuilder(std::move(module))
-            .setEngineKind(llvm::EngineKind::Kind::JIT)
-            .setOptLevel(static_cast<CodeGenOptLevel>(opt_level))
-            .setErrorStr(&error)
-            .create());
+    // Create some module to put our function into it.
+    std::unique_ptr<llvm::Module> module
+        = make_unique<llvm::Module>("SymEngine", *context.get());
+    module->setDataLayout("");
+    mod = module.get();
 
-    // This is a hack to get the MemoryBuffer of a compiled object.
-    class MemoryBufferRefCallback : public llvm::ObjectCache
-    {
-    public:
-        std::string &ss_;
-        MemoryBufferRefCallback(std::string &ss) : ss_(ss) {}
+    std::unique_ptr<llvm::TargetMachine> target_machine;
+    if (batch) {
+        target_machine.reset(get_host_target_machine(opt_level));
+        module->setDataLayout(target_machine->createDataLayout());
+        module->setTargetTriple(target_machine->getTargetTriple().str());
+    }
 
-        void notifyObjectCompiled(const llvm::Module *M,
-                                  llvm::MemoryBufferRef obj) override
-        {
-            const char *c = obj.getBufferStart();
-            // Saving the object code in a std::string
-            ss_.assign(c, obj.getBufferSize());
+    auto F = get_function_type(context.get());
+    llvm::Function *BF = nullptr;
+    if (batch) {
+        BF = get_batch_function_type(context.get());
+        set_preferred_vector_width(BF, *target_machine);
+    }
+
+    std::vector<std::string> objects;
+    if (nchunks == 1) {
+        codegen(F, BF, outputs, symbolic_cse);
+        optimize(F, BF, opt_level, target_machine.get());
+    } else {
+        // Every chunk of outputs is a module in its own context. The IR is
+        // generated here, but optimized and compiled in parallel. The
+        // functions `F` and `BF` only call the function of each chunk with
+        // the outputs shifted by the offset of the chunk.
+        struct Chunk {
+            std::unique_ptr<llvm::LLVMContext> context;
+            std::unique_ptr<llvm::Module> module;
+            std::unique_ptr<llvm::TargetMachine> target_machine;
+            llvm::Function *F, *BF = nullptr;
+            std::string object;
+        };
+        std::vector<Chunk> chunks(nchunks);
+        llvm::IRBuilder<> _builder(
+            llvm::BasicBlock::Create(*context, "EntryBlock", F));
+        llvm::IRBuilder<> _batch_builder(*context);
+        if (batch) {
+            _batch_builder.SetInsertPoint(
+                llvm::BasicBlock::Create(*context, "entry", BF));
+        }
+        for (size_t c = 0; c < nchunks; c++) {
+            size_t begin = c * outputs.size() / nchunks;
+            size_t end = (c + 1) * outputs.size() / nchunks;
+            const std::string name = "chunk" + std::to_string(c);
+            Chunk &chunk = chunks[c];
+            chunk.context = make_unique<llvm::LLVMContext>();
+            chunk.module = make_unique<llvm::Module>(name, *chunk.context);
+            mod = chunk.module.get();
+            chunk.F = get_function_type(chunk.context.get());
+            chunk.F->setName(name);
+            chunk.F->setLinkage(llvm::Function::ExternalLinkage);
+            if (batch) {
+                chunk.target_machine.reset(get_host_target_machine(opt_level));
+                mod->setDataLayout(
+                    chunk.target_machine->createDataLayout());
+                mod->setTargetTriple(
+                    chunk.target_machine->getTargetTriple().str());
+                chunk.BF = get_batch_function_type(chunk.context.get());
+                chunk.BF->setName(name + "_batch");
+                chunk.BF->setLinkage(llvm::Function::ExternalLinkage);
+                set_preferred_vector_width(chunk.BF, *chunk.target_machine);
+            }
+            codegen(chunk.F, chunk.BF,
+                    vec_basic(outputs.begin() + begin, outputs.begin() + end),
+                    symbolic_cse);
+            mod = module.get();
+
+            auto args = F->arg_begin();
+            llvm::Value *inps = &*args++;
+            llvm::Value *outs = _builder.CreateGEP(
+                get_float_type(context.get()), &*args,
+                llvm::ConstantInt::get(llvm::Type::getInt32Ty(*context),
+                                       begin));
+            _builder.CreateCall(
+                llvm::Function::Create(F->getFunctionType(),
+                                       llvm::Function::ExternalLinkage, name,
+                                       mod),
+                {inps, outs});
+            if (batch) {
+                args = BF->arg_begin();
+                inps = &*args++;
+                llvm::Value *bouts = &*args++;
+                llvm::Value *n = &*args;
+                auto offset = _batch_builder.CreateMul(
+                    n, llvm::ConstantInt::get(n->getType(), begin), "", true,
+                    true);
+                bouts = _batch_builder.CreateGEP(get_float_type(context.get()),
+                                                 bouts, offset);
+                _batch_builder.CreateCall(
+                    llvm::Function::Create(BF->getFunctionType(),
+                                           llvm::Function::ExternalLinkage,
+                                           name + "_batch", mod),
+                    {inps, bouts, n});
+            }
+        }
+        _builder.CreateRetVoid();
+        if (batch) {
+            _batch_builder.CreateRetVoid();
         }
 
-        std::unique_ptr<llvm::MemoryBuffer>
-        getObject(const llvm::Module *M) override
-        {
-            return NULL;
+        std::atomic<size_t> next_chunk(0);
+        auto compile_chunks = [&]() {
+            for (size_t c = next_chunk++; c < nchunks; c = next_chunk++) {
+                Chunk &chunk = chunks[c];
+                optimize(chunk.F, chunk.BF, opt_level,
+                         chunk.target_machine.get());
+                auto engine = create_engine(std::move(chunk.module), opt_level,
+                                            std::move(chunk.target_machine));
+                MemoryBufferRefCallback callback(chunk.object);
+                engine->setObjectCache(&callback);
+                engine->finalizeObject();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (unsigned i = 1; i < std::min<size_t>(nthreads, nchunks); i++) {
+            threads.emplace_back(compile_chunks);
         }
-    };
+        compile_chunks();
+        for (auto &t : threads) {
+            t.join();
+        }
+        for (auto &chunk : chunks) {
+            objects.push_back(std::move(chunk.object));
+        }
+    }
 
-    MemoryBufferRefCallback callback(membuffer);
+    // Now we create the JIT.
+    executionengine = create_engine(std::move(module), opt_level,
+                                    std::move(target_machine));
+    add_objects(*executionengine, objects);
+
+    std::string object;
+    MemoryBufferRefCallback callback(object);
     executionengine->setObjectCache(&callback);
-    // std::cout << error << std::endl;
     executionengine->finalizeObject();
+    if (objects.empty()) {
+        membuffer = std::move(object);
+    } else {
+        objects.insert(objects.begin(), std::move(object));
+        membuffer = pack_objects(objects);
+    }
 
     // Get the symbol's address
     func = (intptr_t)executionengine->getPointerToFunction(F);
+    if (batch) {
+        batch_func = (intptr_t)executionengine->getPointerToFunction(BF);
+    }
+    if (not cache_path.empty()) {
+        write_cache_entry(cache_path, cache_key, membuffer);
+    }
     symbol_ptrs.clear();
     replacement_symbol_ptrs.clear();
     symbols.clear();
@@ -324,6 +884,15 @@ void LLVMDoubleVisitor::call(double *outs, const double *inps) const
     ((double (*)(const double *, double *))func)(inps, outs);
 }
 
+void LLVMDoubleVisitor::call_batch(double *outs, const double *inps,
+                                   size_t n) const
+{
+    if (not batch_func) {
+        throw SymEngineException("call_batch requires init with batch=true");
+    }
+    ((void (*)(const double *, double *, size_t))batch_func)(inps, outs, n);
+}
+
 #ifdef SYMENGINE_HAVE_LLVM_LONG_DOUBLE
 long double
 LLVMLongDoubleVisitor::call(const std::vector<long double> &vec) const
@@ -339,6 +908,16 @@ void LLVMLongDoubleVisitor::call(long double *outs,
 {
     ((long double (*)(const long double *, long double *))func)(inps, outs);
 }
+
+void LLVMLongDoubleVisitor::call_batch(long double *outs,
+                                       const long double *inps, size_t n) const
+{
+    if (not batch_func) {
+        throw SymEngineException("call_batch requires init with batch=true");
+    }
+    ((void (*)(const long double *, long double *, size_t))batch_func)(
+        inps, outs, n);
+}
 #endif
 
 LLVMFloatVisitor::LLVMFloatVisitor() = default;
@@ -356,6 +935,15 @@ void LLVMFloatVisitor::call(float *outs, const float *inps) const
     ((float (*)(const float *, float *))func)(inps, outs);
 }
 
+void LLVMFloatVisitor::call_batch(float *outs, const float *inps,
+                                  size_t n) const
+{
+    if (not batch_func) {
+        throw SymEngineException("call_batch requires init with batch=true");
+    }
+    ((void (*)(const float *, float *, size_t))batch_func)(inps, outs, n);
+}
+
 void LLVMVisitor::set_double(double d)
 {
     result_ = llvm::ConstantFP::get(get_float_type(&mod->getContext()), d);
@@ -924,6 +1512,11 @@ llvm::Function *LLVMVisitor::get_external_function(const std::string &name,
 #else
     func->addFnAttr(llvm::Attribute::NoUnwind);
 #endif
+    if (pure_external_functions) {
+        // errno is never inspected, so that the calls can be hoisted and
+        // vectorized like the intrinsics
+        func->setDoesNotAccessMemory();
+    }
     return func;
 }
 
@@ -951,7 +1544,18 @@ const std::string &LLVMVisitor::dumps() const
 
 void LLVMVisitor::loads(const std::string &s)
 {
+    // The first object contains the function, the others the chunks it calls
+    std::vector<std::string> objects;
+    if (not unpack_objects(s, objects)) {
+        objects.push_back(s);
+    }
+    std::string object = std::move(objects.front());
+    objects.erase(objects.begin());
+
+    // The module of a previous engine refers to the context
+    executionengine.reset();
     membuffer = s;
+    batch_func = 0;
     llvm::InitializeNativeTarget();
     llvm::InitializeNativeTargetAsmPrinter();
     llvm::InitializeNativeTargetAsmParser();
@@ -997,11 +1601,14 @@ void LLVMVisitor::loads(const std::string &s)
         }
     };
 
-    MCJITObjectLoader loader(s);
+    MCJITObjectLoader loader(object);
     executionengine->setObjectCache(&loader);
+    add_objects(*executionengine, objects);
     executionengine->finalizeObject();
     // Set func to compiled function pointer
     func = (intptr_t)executionengine->getPointerToFunction(F);
+    // The loop over many points is only present if compiled with `batch`
+    batch_func = (intptr_t)executionengine->getFunctionAddress("batch");
 }
 
 void LLVMVisitor::bvisit(const Floor &x)
@@ -24,6 +24,14 @@ namespace SymEngine
 
 class IRBuilder;
 
+// Directory in which `LLVMVisitor::init` saves the compiled object code and
+// looks it up before compiling again. The entries are keyed on the inputs,
+// outputs, options and the target, so that one directory can be shared by
+// several processes. An empty path (the default unless the environment
+// variable SYMENGINE_LLVM_CACHE_DIR is set) disables the cache.
+void set_llvm_cache_directory(const std::string &path);
+const std::string &get_llvm_cache_directory();
+
 class LLVMVisitor : public BaseVisitor<LLVMVisitor>
 {
 protected:
@@ -36,22 +44,41 @@ protected:
     std::unique_ptr<llvm::ExecutionEngine> executionengine;
 
     intptr_t func;
+    // Entry point of the multi-point loop, only set by `init(..., batch=true)`
+    intptr_t batch_func = 0;
 
     // Following are invalid after the init call.
     IRBuilder *builder;
     llvm::Module *mod;
     std::string membuffer;
+    // Whether the libm functions are declared as not accessing memory, which
+    // lets the batch loop hoist and vectorize calls to them
+    bool pure_external_functions = false;
     llvm::Function *get_function_type(llvm::LLVMContext *);
+    llvm::Function *get_batch_function_type(llvm::LLVMContext *);
+    // Generate the bodies of `F` and, unless it is null, of the loop `BF`
+    // evaluating `outputs` in terms of `symbols`.
+    void codegen(llvm::Function *F, llvm::Function *BF,
+                 const vec_basic &outputs, bool symbolic_cse);
     virtual llvm::Type *get_float_type(llvm::LLVMContext *) = 0;
 
 public:
     LLVMVisitor();
     ~LLVMVisitor() override;
     llvm::Value *apply(const Basic &b);
+    // If `batch` is true, a second function looping over many points is
+    // compiled for the host CPU so that it can be vectorized (see
+    // `call_batch`).
     void init(const vec_basic &x, const Basic &b,
-              const bool symbolic_cse = false, unsigned opt_level = 3);
+              const bool symbolic_cse = false, unsigned opt_level = 3,
+              const bool batch = false);
+    // With `nthreads > 1` the outputs are split into chunks, which are
+    // optimized and compiled in parallel as separate functions. This is
+    // much faster for thousands of outputs, but subexpressions are only
+    // shared within a chunk.
     void init(const vec_basic &inputs, const vec_basic &outputs,
-              const bool symbolic_cse = false, unsigned opt_level = 3);
+              const bool symbolic_cse = false, unsigned opt_level = 3,
+              const bool batch = false, unsigned nthreads = 1);
 
     // Helper functions
     void set_double(double d);
@@ -109,6 +136,9 @@ public:
     ~LLVMDoubleVisitor() override;
     double call(const std::vector<double> &vec) const;
     void call(double *outs, const double *inps) const;
+    // Evaluate at `n` points: input `j` of point `k` is `inps[j*n+k]` and
+    // output `i` is written to `outs[i*n+k]`. Requires `batch=true` in `init`.
+    void call_batch(double *outs, const double *inps, size_t n) const;
     llvm::Type *get_float_type(llvm::LLVMContext *) override;
     void visit(const Tan &x) override;
     void visit(const ASin &x) override;
@@ -134,6 +164,7 @@ public:
     ~LLVMFloatVisitor() override;
     float call(const std::vector<float> &vec) const;
     void call(float *outs, const float *inps) const;
+    void call_batch(float *outs, const float *inps, size_t n) const;
     llvm::Type *get_float_type(llvm::LLVMContext *) override;
     void visit(const Tan &x) override;
     void visit(const ASin &x) override;
@@ -161,6 +192,7 @@ public:
     ~LLVMLongDoubleVisitor() override;
     long double call(const std::vector<long double> &vec) const;
     void call(long double *outs, const long double *inps) const;
+    void call_batch(long double *outs, const long double *inps, size_t n) const;
     llvm::Type *get_float_type(llvm::LLVMContext *) override;
     void visit(const Tan &x) override;
     void visit(const ASin &x) override;
@@ -453,6 +453,18 @@ public:
                               const std::vector<unsigned> &i,
                               const std::vector<unsigned> &j,
                               const vec_basic &x);
+    // Structural sparsity pattern of the jacobian of `exprs` with respect to
+    // `x`: the row pointers `p` and, for every row, the sorted columns of
+    // the symbols that appear in the expression.
+    static void jacobian_sparsity(const vec_basic &exprs, const vec_sym &x,
+                                  std::vector<unsigned> &p,
+                                  std::vector<unsigned> &j);
+    // Jacobian with the pattern from `jacobian_sparsity`. Entries are kept
+    // even if they are zero, so that the structure can be reused.
+    static CSRMatrix jacobian(const vec_basic &exprs, const vec_sym &x,
+                              const std::vector<unsigned> &p,
+                              const std::vector<unsigned> &j,
+                              bool diff_cache = true);
     static CSRMatrix jacobian(const vec_basic &exprs, const vec_sym &x,
                               bool diff_cache = true);
     static CSRMatrix jacobian(const DenseMatrix &A, const DenseMatrix &x,
@@ -470,6 +482,16 @@ public:
         const CSRMatrix &A, const CSRMatrix &B, CSRMatrix &C,
         RCP<const Basic> (&bin_op)(const RCP<const Basic> &,
                                    const RCP<const Basic> &));
+    // Fill reducing ordering of the rows and columns of a square matrix
+    friend std::vector<unsigned>
+    csr_minimum_degree_ordering(const CSRMatrix &A);
+    // Sparse LU factorization with row pivoting: entry (k, m) of `L U` is
+    // `A[p[k], q[m]]`, `L` is unit lower triangular and the first entry of a
+    // nonzero row of `U` is its pivot. The columns are taken in minimum
+    // degree order if `reorder` is true. Returns the rank of `A`.
+    friend unsigned csr_LU(const CSRMatrix &A, CSRMatrix &L, CSRMatrix &U,
+                           std::vector<unsigned> &p, std::vector<unsigned> &q,
+                           bool reorder);
 
 private:
     std::vector<unsigned> p_;
@@ -536,9 +558,14 @@ void pivoted_LU_solve(const DenseMatrix &A, const DenseMatrix &b,
                       DenseMatrix &x);
 
 void LDL_solve(const DenseMatrix &A, const DenseMatrix &b, DenseMatrix &x);
+// Multi-modular solve for a nonsingular matrix with Integer or Rational
+// entries
+void modular_solve(const DenseMatrix &A, const DenseMatrix &b, DenseMatrix &x);
 
 // Determinant
 RCP<const Basic> det_berkowitz(const DenseMatrix &A);
+// Multi-modular determinant of a matrix with Integer or Rational entries
+RCP<const Basic> det_modular(const DenseMatrix &A);
 
 // Characteristic polynomial: Only the coefficients of monomials in decreasing
 // order of monomial powers is returned, i.e. if `B = transpose([1, -2, 3])`
@@ -129,7 +129,7 @@ RCP<const SymEngine::Basic> Mul::from_dict(const RCP<const Number> &coef,
                 }
             } else {
                 // For coef*x or coef*x**3 we simply return Mul:
-                return make_rcp<const Mul>(coef, std::move(d));
+                return intern(make_rcp<const Mul>(coef, std::move(d)));
             }
         }
         if (coef->is_one()) {
@@ -137,12 +137,12 @@ RCP<const SymEngine::Basic> Mul::from_dict(const RCP<const Number> &coef,
             if (eq(*p->second, *one)) {
                 return p->first;
             }
-            return make_rcp<const Pow>(p->first, p->second);
+            return intern(make_rcp<const Pow>(p->first, p->second));
         } else {
-            return make_rcp<const Mul>(coef, std::move(d));
+            return intern(make_rcp<const Mul>(coef, std::move(d)));
         }
     } else {
-        return make_rcp<const Mul>(coef, std::move(d));
+        return intern(make_rcp<const Mul>(coef, std::move(d)));
     }
 }
 
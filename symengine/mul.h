@@ -122,6 +122,17 @@ public:
 
     vec_basic get_args() const override;
 
+    //! Calls `f(base, exp)` for every factor `base**exp` of the dictionary.
+    //! Together with `get_coef()` this visits all the factors of the Mul
+    //! without constructing any objects, unlike `get_args()`.
+    template <typename F>
+    inline void for_each_factor(F &&f) const
+    {
+        for (const auto &p : dict_) {
+            f(p.first, p.second);
+        }
+    }
+
     inline const RCP<const Number> &get_coef() const
     {
         return coef_;
@@ -2,6 +2,7 @@
 #define SYMENGINE_CANCEL_H
 
 #include <symengine/basic.h>
+#include <symengine/ntheory.h>
 #include <symengine/polys/basic_conversions.h>
 
 namespace SymEngine
@@ -35,5 +36,39 @@ inline void cancel(const RCP<const Basic> &numer, const RCP<const Basic> &denom,
     divides_upoly(*gcd_poly, *denom_poly, outArg(*result_denom));
     *common = gcd_poly;
 }
+
+// Multivariate version, the generators of `numer` and `denom` are merged
+inline void cancel(const RCP<const Basic> &numer, const RCP<const Basic> &denom,
+                   const Ptr<RCP<const MIntPoly>> &result_numer,
+                   const Ptr<RCP<const MIntPoly>> &result_denom,
+                   const Ptr<RCP<const MIntPoly>> &common)
+{
+    // generators are pow(base, 1/d); a base found in both uses the lcm of d
+    auto gen_den = [](const Number &e) {
+        return is_a<Rational>(e) ? down_cast<const Rational &>(e).get_den()
+                                 : integer(1);
+    };
+    umap_basic_num gens_map = _find_gens_poly(numer);
+    for (const auto &it : _find_gens_poly(denom)) {
+        auto p = gens_map.find(it.first);
+        if (p == gens_map.end())
+            gens_map.insert(it);
+        else if (neq(*p->second, *it.second))
+            p->second = divnum(
+                one, lcm(*gen_den(*p->second), *gen_den(*it.second)));
+    }
+    set_basic gens;
+    for (const auto &it : gens_map)
+        gens.insert(pow(it.first, it.second));
+
+    RCP<const MIntPoly> numer_poly = from_basic<MIntPoly>(numer, gens);
+    RCP<const MIntPoly> denom_poly = from_basic<MIntPoly>(denom, gens);
+
+    RCP<const MIntPoly> gcd_poly = gcd_mpoly(*numer_poly, *denom_poly);
+
+    divides_mpoly(*gcd_poly, *numer_poly, outArg(*result_numer));
+    divides_mpoly(*gcd_poly, *denom_poly, outArg(*result_denom));
+    *common = gcd_poly;
+}
 } // namespace SymEngine
 #endif // SYMENGINE_CANCEL_H
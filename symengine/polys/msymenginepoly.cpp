@@ -127,4 +127,569 @@ unsigned int reconcile(vec_uint &v1, vec_uint &v2, set_basic &s,
     return pos;
 }
 
+// The division and GCD routines below keep the terms in std::map, whose
+// order on the exponent vectors is the lexicographic one.
+
+typedef std::map<vec_uint, integer_class> lex_mpz;
+
+static lex_mpz to_lex(const MIntDict &a)
+{
+    return lex_mpz(a.dict_.begin(), a.dict_.end());
+}
+
+static MIntDict from_lex(const lex_mpz &a, unsigned int n)
+{
+    return MIntDict(umap_uvec_mpz(a.begin(), a.end()), n);
+}
+
+// Divides `a` by its content and makes its leading coefficient positive,
+// returns the content
+static integer_class make_primitive(lex_mpz &a)
+{
+    integer_class c(0);
+    for (const auto &t : a) {
+        mp_gcd(c, c, t.second);
+        if (c == 1)
+            break;
+    }
+    if (a.empty())
+        return c;
+    if (a.rbegin()->second < 0)
+        c = -c;
+    if (c != 1) {
+        for (auto &t : a)
+            mp_divexact(t.second, t.second, c);
+    }
+    return mp_abs(c);
+}
+
+// Divides `a` by the nonzero `b`. If `exact`, returns false as soon as a term
+// is found that the leading term of `b` does not divide.
+static bool lex_divrem(lex_mpz a, const lex_mpz &b, lex_mpz &q, lex_mpz &r,
+                       bool exact)
+{
+    q.clear();
+    r.clear();
+    const vec_uint &lm = b.rbegin()->first;
+    const integer_class &lc = b.rbegin()->second;
+    const size_t n = lm.size();
+    vec_uint m(n), e(n);
+    integer_class c, rem, t;
+    while (not a.empty()) {
+        auto lt = std::prev(a.end());
+        bool divisible = true;
+        for (size_t i = 0; i < n and divisible; i++) {
+            if (lt->first[i] < lm[i])
+                divisible = false;
+            else
+                m[i] = lt->first[i] - lm[i];
+        }
+        if (divisible) {
+            mp_tdiv_qr(c, rem, lt->second, lc);
+            divisible = (rem == 0);
+        }
+        if (not divisible) {
+            if (exact)
+                return false;
+            r.insert(*lt);
+            a.erase(lt);
+            continue;
+        }
+        for (const auto &bt : b) {
+            for (size_t i = 0; i < n; i++)
+                e[i] = bt.first[i] + m[i];
+            t = c * bt.second;
+            auto it = a.find(e);
+            if (it == a.end()) {
+                a.insert({e, -t});
+            } else {
+                it->second -= t;
+                if (it->second == 0)
+                    a.erase(it);
+            }
+        }
+        q.insert({m, c});
+    }
+    return true;
+}
+
+void MIntDict::divrem(const MIntDict &a, const MIntDict &b, MIntDict &q,
+                      MIntDict &r)
+{
+    SYMENGINE_ASSERT(a.vec_size == b.vec_size)
+    if (b.empty())
+        throw DivisionByZeroError("ZeroDivisionError");
+    lex_mpz lq, lr;
+    lex_divrem(to_lex(a), to_lex(b), lq, lr, false);
+    q = from_lex(lq, a.vec_size);
+    r = from_lex(lr, a.vec_size);
+}
+
+bool MIntDict::divides(const MIntDict &a, const MIntDict &b, MIntDict &res)
+{
+    SYMENGINE_ASSERT(a.vec_size == b.vec_size)
+    if (a.empty())
+        return false;
+    lex_mpz lq, lr;
+    if (not lex_divrem(to_lex(b), to_lex(a), lq, lr, true))
+        return false;
+    res = from_lex(lq, a.vec_size);
+    return true;
+}
+
+static uint64_t powmod_word(uint64_t a, uint64_t e, uint64_t p)
+{
+    uint64_t r = 1;
+    a %= p;
+    while (e > 0) {
+        if (e & 1)
+            r = r * a % p;
+        a = a * a % p;
+        e >>= 1;
+    }
+    return r;
+}
+
+static uint64_t mod_word(const integer_class &a, uint64_t p)
+{
+    integer_class t;
+    mp_fdiv_r(t, a, integer_class(static_cast<unsigned long>(p)));
+    return mp_get_ui(t);
+}
+
+// Polynomials over GF(p), p < 2**31: univariate ones are dense vectors,
+// lowest degree first and without trailing zeros; multivariate ones map the
+// exponent vectors of their nonzero terms to the coefficients; recursive
+// ones map the exponents of all but one variable to univariate polynomials
+// in that variable.
+typedef std::vector<uint64_t> upoly_mod;
+typedef std::map<vec_uint, uint64_t> mpoly_mod;
+typedef std::map<vec_uint, upoly_mod> rpoly_mod;
+
+static void strip_mod(upoly_mod &a)
+{
+    while (not a.empty() and a.back() == 0)
+        a.pop_back();
+}
+
+static uint64_t ueval_mod(const upoly_mod &a, uint64_t x, uint64_t p)
+{
+    uint64_t r = 0;
+    for (size_t i = a.size(); i-- > 0;)
+        r = (r * x + a[i]) % p;
+    return r;
+}
+
+static upoly_mod umul_mod(const upoly_mod &a, const upoly_mod &b, uint64_t p)
+{
+    if (a.empty() or b.empty())
+        return {};
+    upoly_mod r(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < a.size(); i++) {
+        for (size_t j = 0; j < b.size(); j++)
+            r[i + j] = (r[i + j] + a[i] * b[j]) % p;
+    }
+    return r;
+}
+
+// Long division of `a` by the nonzero `b`, the remainder is left in `a`
+static upoly_mod udivrem_mod(upoly_mod &a, const upoly_mod &b, uint64_t p)
+{
+    const size_t db = b.size() - 1;
+    if (a.size() <= db)
+        return {};
+    upoly_mod q(a.size() - db, 0);
+    const uint64_t inv = powmod_word(b[db], p - 2, p);
+    for (size_t i = a.size(); i-- > db;) {
+        const uint64_t c = a[i] * inv % p;
+        q[i - db] = c;
+        if (c == 0)
+            continue;
+        for (size_t j = 0; j <= db; j++)
+            a[i - db + j] = (a[i - db + j] + (p - c) * b[j]) % p;
+    }
+    a.resize(db);
+    strip_mod(a);
+    return q;
+}
+
+// monic GCD
+static upoly_mod ugcd_mod(upoly_mod a, upoly_mod b, uint64_t p)
+{
+    while (not b.empty()) {
+        udivrem_mod(a, b, p);
+        std::swap(a, b);
+    }
+    const uint64_t inv = powmod_word(a.back(), p - 2, p);
+    for (auto &e : a)
+        e = e * inv % p;
+    return a;
+}
+
+static rpoly_mod to_rec(const mpoly_mod &a, unsigned v)
+{
+    rpoly_mod r;
+    for (const auto &t : a) {
+        vec_uint e = t.first;
+        const unsigned d = e[v];
+        e[v] = 0;
+        upoly_mod &c = r[e];
+        if (c.size() <= d)
+            c.resize(d + 1, 0);
+        c[d] = t.second;
+    }
+    return r;
+}
+
+static mpoly_mod from_rec(const rpoly_mod &a, unsigned v)
+{
+    mpoly_mod r;
+    for (const auto &t : a) {
+        vec_uint e = t.first;
+        for (unsigned d = 0; d < t.second.size(); d++) {
+            if (t.second[d] == 0)
+                continue;
+            e[v] = d;
+            r.insert({e, t.second[d]});
+        }
+    }
+    return r;
+}
+
+static upoly_mod content_mod(const rpoly_mod &a, uint64_t p)
+{
+    upoly_mod c;
+    for (const auto &t : a) {
+        c = ugcd_mod(c, t.second, p);
+        if (c.size() == 1)
+            break;
+    }
+    return c;
+}
+
+static mpoly_mod eval_rec(const rpoly_mod &a, uint64_t x, uint64_t p)
+{
+    mpoly_mod r;
+    for (const auto &t : a) {
+        const uint64_t c = ueval_mod(t.second, x, p);
+        if (c != 0)
+            r.insert({t.first, c});
+    }
+    return r;
+}
+
+// true if the nonzero `a` divides `b`
+static bool mdivides_mod(const mpoly_mod &a, mpoly_mod b, uint64_t p)
+{
+    const vec_uint &lm = a.rbegin()->first;
+    const size_t n = lm.size();
+    const uint64_t inv = powmod_word(a.rbegin()->second, p - 2, p);
+    vec_uint m(n), e(n);
+    while (not b.empty()) {
+        auto lt = std::prev(b.end());
+        for (size_t i = 0; i < n; i++) {
+            if (lt->first[i] < lm[i])
+                return false;
+            m[i] = lt->first[i] - lm[i];
+        }
+        const uint64_t c = p - lt->second * inv % p;
+        for (const auto &t : a) {
+            for (size_t i = 0; i < n; i++)
+                e[i] = t.first[i] + m[i];
+            auto it = b.insert({e, 0}).first;
+            it->second = (it->second + c * t.second) % p;
+            if (it->second == 0)
+                b.erase(it);
+        }
+    }
+    return true;
+}
+
+// Newton interpolation in the variable `v` of the images at `points`
+static rpoly_mod interpolate_mod(const std::vector<uint64_t> &points,
+                                 const std::vector<mpoly_mod> &images,
+                                 unsigned v, uint64_t p)
+{
+    rpoly_mod h;
+    upoly_mod q = {1};
+    for (size_t i = 0; i < points.size(); i++) {
+        const uint64_t x = points[i];
+        mpoly_mod d = images[i];
+        for (const auto &t : h) {
+            const uint64_t c = ueval_mod(t.second, x, p);
+            if (c == 0)
+                continue;
+            auto it = d.insert({t.first, 0}).first;
+            it->second = (it->second + p - c) % p;
+        }
+        const uint64_t s = powmod_word(ueval_mod(q, x, p), p - 2, p);
+        for (const auto &t : d) {
+            if (t.second == 0)
+                continue;
+            const uint64_t c = t.second * s % p;
+            upoly_mod &g = h[t.first];
+            if (g.size() < q.size())
+                g.resize(q.size(), 0);
+            for (size_t j = 0; j < q.size(); j++)
+                g[j] = (g[j] + c * q[j]) % p;
+        }
+        q = umul_mod(q, {p - x, 1}, p);
+    }
+    for (auto it = h.begin(); it != h.end();) {
+        strip_mod(it->second);
+        if (it->second.empty())
+            it = h.erase(it);
+        else
+            ++it;
+    }
+    return h;
+}
+
+// Brown's algorithm: the monic GCD over GF(p) of the nonzero `a` and `b`, in
+// which only the first `k` variables occur. The last of them is eliminated
+// by evaluation at enough points and the images are interpolated.
+static mpoly_mod mgcd_mod(const mpoly_mod &a, const mpoly_mod &b, unsigned k,
+                          uint64_t p)
+{
+    const size_t n = a.begin()->first.size();
+    if (k == 1) {
+        upoly_mod ua, ub;
+        for (const auto &t : a) {
+            if (ua.size() <= t.first[0])
+                ua.resize(t.first[0] + 1, 0);
+            ua[t.first[0]] = t.second;
+        }
+        for (const auto &t : b) {
+            if (ub.size() <= t.first[0])
+                ub.resize(t.first[0] + 1, 0);
+            ub[t.first[0]] = t.second;
+        }
+        const upoly_mod g = ugcd_mod(ua, ub, p);
+        mpoly_mod r;
+        vec_uint e(n, 0);
+        for (unsigned i = 0; i < g.size(); i++) {
+            if (g[i] == 0)
+                continue;
+            e[0] = i;
+            r.insert({e, g[i]});
+        }
+        return r;
+    }
+
+    const unsigned v = k - 1;
+    rpoly_mod ra = to_rec(a, v), rb = to_rec(b, v);
+    const upoly_mod ca = content_mod(ra, p), cb = content_mod(rb, p);
+    const upoly_mod c = ugcd_mod(ca, cb, p);
+    size_t da = 0, db = 0;
+    for (auto &t : ra) {
+        t.second = udivrem_mod(t.second, ca, p);
+        da = std::max(da, t.second.size() - 1);
+    }
+    for (auto &t : rb) {
+        t.second = udivrem_mod(t.second, cb, p);
+        db = std::max(db, t.second.size() - 1);
+    }
+    const mpoly_mod pa = from_rec(ra, v), pb = from_rec(rb, v);
+
+    // The GCD is interpolated with the leading coefficient `g`, which bounds
+    // its degree in `v`
+    const upoly_mod &la = ra.rbegin()->second, &lb = rb.rbegin()->second;
+    const upoly_mod g = ugcd_mod(la, lb, p);
+    size_t needed = g.size() + std::min(da, db);
+
+    std::vector<uint64_t> points, batch;
+    std::vector<mpoly_mod> images, batch_images;
+    uint64_t x = 0;
+    while (true) {
+        batch.clear();
+        while (images.size() + batch.size() < needed) {
+            x++;
+            if (ueval_mod(la, x, p) != 0 and ueval_mod(lb, x, p) != 0)
+                batch.push_back(x);
+        }
+        batch_images.assign(batch.size(), mpoly_mod());
+        const int nb = static_cast<int>(batch.size());
+#pragma omp parallel for schedule(dynamic) if (k > 2 and nb > 1)
+        for (int i = 0; i < nb; i++) {
+            mpoly_mod h = mgcd_mod(eval_rec(ra, batch[i], p),
+                                   eval_rec(rb, batch[i], p), k - 1, p);
+            const uint64_t s = ueval_mod(g, batch[i], p);
+            for (auto &t : h)
+                t.second = t.second * s % p;
+            batch_images[i] = std::move(h);
+        }
+        points.insert(points.end(), batch.begin(), batch.end());
+        images.insert(images.end(), batch_images.begin(), batch_images.end());
+
+        // images with a larger leading monomial come from unlucky points
+        vec_uint lm = images[0].rbegin()->first;
+        for (const auto &h : images)
+            lm = std::min(lm, h.rbegin()->first);
+        size_t j = 0;
+        for (size_t i = 0; i < images.size(); i++) {
+            if (images[i].rbegin()->first != lm)
+                continue;
+            points[j] = points[i];
+            std::swap(images[j], images[i]);
+            j++;
+        }
+        points.resize(j);
+        images.resize(j);
+        if (images.size() < needed)
+            continue;
+
+        rpoly_mod h = interpolate_mod(points, images, v, p);
+        const upoly_mod ch = content_mod(h, p);
+        for (auto &t : h)
+            t.second = udivrem_mod(t.second, ch, p);
+        const mpoly_mod hm = from_rec(h, v);
+        if (mdivides_mod(hm, pa, p) and mdivides_mod(hm, pb, p)) {
+            for (auto &t : h)
+                t.second = umul_mod(t.second, c, p);
+            mpoly_mod r = from_rec(h, v);
+            const uint64_t inv = powmod_word(r.rbegin()->second, p - 2, p);
+            for (auto &t : r)
+                t.second = t.second * inv % p;
+            return r;
+        }
+        // all the points so far were unlucky
+        needed++;
+    }
+}
+
+MIntDict MIntDict::gcd(const MIntDict &a, const MIntDict &b)
+{
+    SYMENGINE_ASSERT(a.vec_size == b.vec_size)
+    const unsigned int n = a.vec_size;
+    lex_mpz f = to_lex(a), g = to_lex(b), q, r;
+    if (f.empty() or g.empty()) {
+        lex_mpz &h = f.empty() ? g : f;
+        if (not h.empty() and h.rbegin()->second < 0) {
+            for (auto &t : h)
+                t.second = -t.second;
+        }
+        return from_lex(h, n);
+    }
+    integer_class c, cf = make_primitive(f), cg = make_primitive(g);
+    mp_gcd(c, cf, cg);
+    const vec_uint zero_v(n, 0);
+    if (f.rbegin()->first == zero_v or g.rbegin()->first == zero_v)
+        return from_lex({{zero_v, c}}, n);
+
+    // the leading coefficient of the GCD divides `gamma`, so the modular
+    // images are scaled to have it as leading coefficient
+    integer_class gamma, m, M, half;
+    mp_gcd(gamma, f.rbegin()->second, g.rbegin()->second);
+    lex_mpz H;
+    vec_uint lm;
+    mpoly_mod fp, gp;
+    uint64_t p = uint64_t(1) << 31;
+    while (true) {
+        do {
+            p--;
+        } while (not mp_probab_prime_p(
+            integer_class(static_cast<unsigned long>(p)), 25));
+        fp.clear();
+        gp.clear();
+        for (const auto &t : f) {
+            const uint64_t u = mod_word(t.second, p);
+            if (u != 0)
+                fp.insert({t.first, u});
+        }
+        for (const auto &t : g) {
+            const uint64_t u = mod_word(t.second, p);
+            if (u != 0)
+                gp.insert({t.first, u});
+        }
+        if (fp.empty() or gp.empty() or fp.rbegin()->first != f.rbegin()->first
+            or gp.rbegin()->first != g.rbegin()->first)
+            continue;
+        mpoly_mod hp = mgcd_mod(fp, gp, n, p);
+        if (hp.rbegin()->first == zero_v)
+            return from_lex({{zero_v, c}}, n);
+        // a larger leading monomial means that `p` is unlucky, a smaller one
+        // that all the previous primes were
+        if (not H.empty() and lm < hp.rbegin()->first)
+            continue;
+        const uint64_t gam = mod_word(gamma, p);
+        for (auto &t : hp)
+            t.second = t.second * gam % p;
+        if (H.empty() or hp.rbegin()->first < lm) {
+            lm = hp.rbegin()->first;
+            H.clear();
+            for (const auto &t : hp) {
+                integer_class &e = H[t.first];
+                e = static_cast<unsigned long>(t.second);
+                if (t.second > p / 2)
+                    e -= static_cast<unsigned long>(p);
+            }
+            m = static_cast<unsigned long>(p);
+            continue;
+        }
+        // CRT in the symmetric range; once the image stops changing it is
+        // checked with trial division
+        for (const auto &t : hp)
+            H.insert({t.first, integer_class(0)});
+        const uint64_t minv = powmod_word(mod_word(m, p), p - 2, p);
+        M = m * static_cast<unsigned long>(p);
+        half = M / 2;
+        bool changed = false;
+        for (auto &t : H) {
+            auto it = hp.find(t.first);
+            const uint64_t u = ((it == hp.end() ? 0 : it->second) + p
+                                - mod_word(t.second, p))
+                               * minv % p;
+            if (u == 0)
+                continue;
+            changed = true;
+            t.second += m * static_cast<unsigned long>(u);
+            if (t.second > half)
+                t.second -= M;
+        }
+        m = M;
+        if (not changed) {
+            lex_mpz h;
+            for (const auto &t : H) {
+                if (t.second != 0)
+                    h.insert(t);
+            }
+            make_primitive(h);
+            if (lex_divrem(f, h, q, r, true) and lex_divrem(g, h, q, r, true)) {
+                for (auto &t : h)
+                    t.second *= c;
+                return from_lex(h, n);
+            }
+        }
+    }
+}
+
+void divrem_mpoly(const MIntPoly &a, const MIntPoly &b,
+                  const Ptr<RCP<const MIntPoly>> &q,
+                  const Ptr<RCP<const MIntPoly>> &r)
+{
+    MIntDict x, y, qd, rd;
+    set_basic s = get_translated_container(x, y, a, b);
+    MIntDict::divrem(x, y, qd, rd);
+    *q = MIntPoly::from_container(s, std::move(qd));
+    *r = MIntPoly::from_container(s, std::move(rd));
+}
+
+bool divides_mpoly(const MIntPoly &a, const MIntPoly &b,
+                   const Ptr<RCP<const MIntPoly>> &res)
+{
+    MIntDict x, y, q;
+    set_basic s = get_translated_container(x, y, a, b);
+    if (not MIntDict::divides(x, y, q))
+        return false;
+    *res = MIntPoly::from_container(s, std::move(q));
+    return true;
+}
+
+RCP<const MIntPoly> gcd_mpoly(const MIntPoly &a, const MIntPoly &b)
+{
+    MIntDict x, y;
+    set_basic s = get_translated_container(x, y, a, b);
+    return MIntPoly::from_container(s, MIntDict::gcd(x, y));
+}
+
 } // namespace SymEngine
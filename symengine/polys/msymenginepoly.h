@@ -1,6 +1,8 @@
 #ifndef SYMENGINE_POLYNOMIALS_MULTIVARIATE
 #define SYMENGINE_POLYNOMIALS_MULTIVARIATE
 
+#include <algorithm>
+#include <limits>
 #include <symengine/expression.h>
 #include <symengine/monomials.h>
 #include <symengine/polys/uintpoly.h>
@@ -10,6 +12,19 @@
 namespace SymEngine
 {
 
+//! `r += a * b`
+inline void mpoly_addmul(integer_class &r, const integer_class &a,
+                         const integer_class &b)
+{
+    mp_addmul(r, a, b);
+}
+
+template <typename T>
+inline void mpoly_addmul(T &r, const T &a, const T &b)
+{
+    r += a * b;
+}
+
 template <typename Vec, typename Value, typename Wrapper>
 class UDictWrapper
 {
@@ -132,18 +147,17 @@ public:
         SYMENGINE_ASSERT(a.vec_size == b.vec_size)
 
         Wrapper p(a.vec_size);
+        if (a.dict_.empty() or b.dict_.empty())
+            return p;
+        if (heap_mul(a, b, p))
+            return p;
+
+        Vec target(a.vec_size, 0);
         for (auto const &a_ : a.dict_) {
             for (auto const &b_ : b.dict_) {
-
-                Vec target(a.vec_size, 0);
                 for (unsigned int i = 0; i < a.vec_size; i++)
                     target[i] = a_.first[i] + b_.first[i];
-
-                if (p.dict_.find(target) == p.dict_.end()) {
-                    p.dict_.insert({target, a_.second * b_.second});
-                } else {
-                    p.dict_.find(target)->second += a_.second * b_.second;
-                }
+                mpoly_addmul(p.dict_[target], a_.second, b_.second);
             }
         }
 
@@ -157,6 +171,115 @@ public:
         return p;
     }
 
+    //! Heap multiplication (Johnson, Monagan-Pearce) of `a` and `b` into the
+    //! empty `p`. The exponent vectors are packed into one word, so that
+    //! the products come out of the heap ordered and each coefficient is
+    //! accumulated in place. Returns false if the exponents do not fit.
+    static bool heap_mul(const Wrapper &a, const Wrapper &b, Wrapper &p)
+    {
+        const unsigned int n = a.vec_size;
+        // the exponents of `a` and `b` are stored relative to their minima
+        std::vector<long long> a_min(n), b_min(n), a_max(n), b_max(n);
+        for (unsigned int i = 0; i < n; i++) {
+            a_min[i] = b_min[i] = std::numeric_limits<long long>::max();
+            a_max[i] = b_max[i] = std::numeric_limits<long long>::min();
+        }
+        for (auto const &t : a.dict_) {
+            for (unsigned int i = 0; i < n; i++) {
+                a_min[i] = std::min<long long>(a_min[i], t.first[i]);
+                a_max[i] = std::max<long long>(a_max[i], t.first[i]);
+            }
+        }
+        for (auto const &t : b.dict_) {
+            for (unsigned int i = 0; i < n; i++) {
+                b_min[i] = std::min<long long>(b_min[i], t.first[i]);
+                b_max[i] = std::max<long long>(b_max[i], t.first[i]);
+            }
+        }
+        std::vector<unsigned int> shift(n);
+        std::vector<uint64_t> mask(n);
+        unsigned int bits = 0;
+        for (unsigned int i = n; i-- > 0;) {
+            const unsigned int w = bit_length(static_cast<unsigned long long>(
+                a_max[i] - a_min[i] + b_max[i] - b_min[i]));
+            shift[i] = bits;
+            mask[i] = (w == 64) ? ~uint64_t(0) : (uint64_t(1) << w) - 1;
+            bits += w;
+            if (bits > 64)
+                return false;
+        }
+
+        typedef std::pair<uint64_t, const Value *> packed_term;
+        auto pack = [&](const Wrapper &x, const std::vector<long long> &lo) {
+            std::vector<packed_term> r;
+            r.reserve(x.dict_.size());
+            for (auto const &t : x.dict_) {
+                uint64_t k = 0;
+                for (unsigned int i = 0; i < n; i++) {
+                    if (mask[i] != 0)
+                        k |= static_cast<uint64_t>(t.first[i] - lo[i])
+                             << shift[i];
+                }
+                r.push_back({k, &t.second});
+            }
+            std::sort(r.begin(), r.end(),
+                      [](const packed_term &u, const packed_term &v) {
+                          return u.first > v.first;
+                      });
+            return r;
+        };
+        std::vector<packed_term> f = pack(a, a_min), g = pack(b, b_min);
+        std::vector<long long> lo(n);
+        for (unsigned int i = 0; i < n; i++)
+            lo[i] = a_min[i] + b_min[i];
+        if (f.size() > g.size())
+            std::swap(f, g);
+
+        // the heap holds at most one product f[i]*g[j] per term of `f`
+        struct heap_entry {
+            uint64_t key;
+            unsigned int i, j;
+        };
+        auto less = [](const heap_entry &u, const heap_entry &v) {
+            return u.key < v.key;
+        };
+        std::vector<heap_entry> heap;
+        heap.reserve(f.size());
+        heap.push_back({f[0].first + g[0].first, 0, 0});
+        p.dict_.reserve(f.size() + g.size());
+        Vec target(n);
+        Value acc;
+        while (not heap.empty()) {
+            const uint64_t key = heap.front().key;
+            acc = Value(0);
+            while (not heap.empty() and heap.front().key == key) {
+                std::pop_heap(heap.begin(), heap.end(), less);
+                const heap_entry e = heap.back();
+                heap.pop_back();
+                mpoly_addmul(acc, *f[e.i].second, *g[e.j].second);
+                if (e.j == 0 and e.i + 1 < f.size()) {
+                    heap.push_back({f[e.i + 1].first + g[0].first, e.i + 1, 0});
+                    std::push_heap(heap.begin(), heap.end(), less);
+                }
+                if (e.j + 1 < g.size()) {
+                    heap.push_back(
+                        {f[e.i].first + g[e.j + 1].first, e.i, e.j + 1});
+                    std::push_heap(heap.begin(), heap.end(), less);
+                }
+            }
+            if (acc == 0)
+                continue;
+            for (unsigned int i = 0; i < n; i++) {
+                const uint64_t e
+                    = mask[i] == 0 ? 0 : (key >> shift[i]) & mask[i];
+                target[i] = static_cast<typename Vec::value_type>(
+                    static_cast<long long>(e) + lo[i]);
+            }
+            p.dict_.insert({target, acc});
+        }
+        return true;
+    }
+
     static Wrapper pow(const Wrapper &a, unsigned int p)
     {
         Wrapper tmp = a, res(a.vec_size);
@@ -281,6 +404,21 @@ public:
     MIntDict(const MIntDict &) = default;
 
     MIntDict &operator=(const MIntDict &) = default;
+
+    //! Division with remainder `a = q*b + r` with respect to the
+    //! lexicographic order of the exponent vectors: the leading term of `b`
+    //! divides no term of `r`
+    static void divrem(const MIntDict &a, const MIntDict &b, MIntDict &q,
+                       MIntDict &r);
+
+    //! true & sets `res` to b/a if a exactly divides b, otherwise false
+    static bool divides(const MIntDict &a, const MIntDict &b, MIntDict &res);
+
+    //! GCD with a positive leading coefficient, computed with Brown's
+    //! modular algorithm: GCDs modulo word-size primes are found by
+    //! evaluating and interpolating one variable at a time and combined
+    //! with CRT
+    static MIntDict gcd(const MIntDict &a, const MIntDict &b);
 };
 
 class MExprDict : public UDictWrapper<vec_int, Expression, MExprDict>
@@ -528,6 +666,17 @@ RCP<const Poly> pow_mpoly(const Poly &a, unsigned int n)
     auto x = a.get_poly();
     return Poly::from_container(a.get_vars(), Poly::container_type::pow(x, n));
 }
+
+// sets `q` and `r` such that a = q*b + r, see MIntDict::divrem
+void divrem_mpoly(const MIntPoly &a, const MIntPoly &b,
+                  const Ptr<RCP<const MIntPoly>> &q,
+                  const Ptr<RCP<const MIntPoly>> &r);
+
+// true & sets `res` to b/a if a exactly divides b, otherwise false & undefined
+bool divides_mpoly(const MIntPoly &a, const MIntPoly &b,
+                   const Ptr<RCP<const MIntPoly>> &res);
+
+RCP<const MIntPoly> gcd_mpoly(const MIntPoly &a, const MIntPoly &b);
 } // namespace SymEngine
 
 #endif
@@ -1,4 +1,5 @@
 #include <symengine/polys/uintpoly.h>
+#include <symengine/fields.h>
 
 namespace SymEngine
 {
@@ -22,41 +23,470 @@ UIntPoly::UIntPoly(const RCP<const Basic> &var, UIntDict &&dict)
     return seed;
 }
 
-bool divides_upoly(const UIntPoly &a, const UIntPoly &b,
-                   const Ptr<RCP<const UIntPoly>> &out)
-{
-    if (!(a.get_var()->__eq__(*b.get_var())))
-        throw SymEngineException("Error: variables must agree.");
+// The GCD and division routines below work on dense coefficient vectors,
+// lowest degree first, with no trailing zeros.
 
-    auto a_poly = a.get_poly();
-    auto b_poly = b.get_poly();
-    if (a_poly.size() == 0)
-        return false;
+static vec_integer_class to_dense(const UIntDict &a)
+{
+    vec_integer_class v;
+    if (a.empty())
+        return v;
+    v.resize(a.degree() + 1);
+    for (const auto &it : a.dict_)
+        v[it.first] = it.second;
+    return v;
+}
 
-    map_uint_mpz res;
-    UIntDict tmp;
-    integer_class q, r;
-    unsigned int a_deg, b_deg;
+static UIntDict from_dense(const vec_integer_class &v)
+{
+    UIntDict r;
+    for (unsigned int i = 0; i < v.size(); i++) {
+        if (v[i] != 0)
+            r.dict_[i] = v[i];
+    }
+    return r;
+}
 
-    while (b_poly.size() >= a_poly.size()) {
-        a_deg = a_poly.degree();
-        b_deg = b_poly.degree();
+// Divides `v` by its content and makes its leading coefficient positive,
+// returns the content
+static integer_class make_primitive(vec_integer_class &v)
+{
+    integer_class c(0);
+    for (const auto &e : v) {
+        mp_gcd(c, c, e);
+        if (c == 1)
+            break;
+    }
+    if (v.empty())
+        return c;
+    if (v.back() < 0)
+        c = -c;
+    if (c != 1) {
+        for (auto &e : v)
+            mp_divexact(e, e, c);
+    }
+    return mp_abs(c);
+}
 
-        mp_tdiv_qr(q, r, b_poly.get_lc(), a_poly.get_lc());
+// true & sets `q` to b/a if a exactly divides b, otherwise false
+static bool divides_dense(const vec_integer_class &a, vec_integer_class b,
+                          vec_integer_class &q)
+{
+    q.clear();
+    if (b.size() < a.size())
+        return b.empty();
+    const size_t da = a.size() - 1;
+    q.resize(b.size() - da);
+    integer_class r;
+    for (size_t i = b.size(); i-- > da;) {
+        if (b[i] == 0)
+            continue;
+        mp_tdiv_qr(q[i - da], r, b[i], a[da]);
         if (r != 0)
             return false;
+        for (size_t j = 0; j < da; j++)
+            b[i - da + j] -= q[i - da] * a[j];
+    }
+    for (size_t i = 0; i < da; i++) {
+        if (b[i] != 0)
+            return false;
+    }
+    return true;
+}
 
-        res[b_deg - a_deg] = q;
-        UIntDict tmp = UIntDict({{b_deg - a_deg, q}});
-        b_poly -= (a_poly * tmp);
+static integer_class eval_dense(const vec_integer_class &v,
+                                const integer_class &x)
+{
+    integer_class r(0);
+    for (size_t i = v.size(); i-- > 0;) {
+        r *= x;
+        r += v[i];
     }
+    return r;
+}
+
+// Recovers the polynomial whose value at `x` is `h` from the digits of `h`
+// in base `x`, taken in the symmetric range
+static vec_integer_class interpolate_dense(integer_class h,
+                                           const integer_class &x)
+{
+    vec_integer_class f;
+    integer_class g, half = x / 2;
+    while (h != 0) {
+        mp_fdiv_r(g, h, x);
+        if (g > half)
+            g -= x;
+        f.push_back(g);
+        h -= g;
+        mp_divexact(h, h, x);
+    }
+    return f;
+}
 
-    if (b_poly.empty()) {
-        *out = UIntPoly::from_dict(a.get_var(), std::move(res));
+static integer_class max_abs_dense(const vec_integer_class &v)
+{
+    integer_class m(0);
+    for (const auto &e : v) {
+        if (mp_abs(e) > m)
+            m = mp_abs(e);
+    }
+    return m;
+}
+
+// Removes the contents of `a` and `b`; returns false (and sets `res`) if the
+// GCD is already known then
+static bool gcd_prepare(const UIntDict &a, const UIntDict &b,
+                        vec_integer_class &f, vec_integer_class &g,
+                        integer_class &c, UIntDict &res)
+{
+    f = to_dense(a);
+    g = to_dense(b);
+    if (f.empty() or g.empty()) {
+        res = from_dense(f.empty() ? g : f);
+        if (not res.empty() and res.get_lc() < 0)
+            res = -res;
+        return false;
+    }
+    integer_class cf = make_primitive(f), cg = make_primitive(g);
+    mp_gcd(c, cf, cg);
+    if (f.size() == 1 or g.size() == 1) {
+        res = UIntDict(c);
+        return false;
+    }
+    return true;
+}
+
+static UIntDict gcd_finish(vec_integer_class &h, const integer_class &c)
+{
+    for (auto &e : h)
+        e *= c;
+    return from_dense(h);
+}
+
+UIntDict UIntDict::gcd(const UIntDict &a, const UIntDict &b)
+{
+    UIntDict res;
+    if (gcd_heu(a, b, res))
+        return res;
+    return gcd_modular(a, b);
+}
+
+bool UIntDict::gcd_heu(const UIntDict &a, const UIntDict &b, UIntDict &res)
+{
+    vec_integer_class f, g, h, q, cand;
+    integer_class c;
+    if (not gcd_prepare(a, b, f, g, c, res))
+        return true;
+
+    // accepts `h` if its primitive part divides both `f` and `g`
+    auto accept = [&](vec_integer_class &cand) {
+        make_primitive(cand);
+        if (cand.empty() or not divides_dense(cand, f, q)
+            or not divides_dense(cand, g, q))
+            return false;
+        res = gcd_finish(cand, c);
         return true;
-    } else {
+    };
+
+    // the evaluation points of sympy's dup_zz_heu_gcd
+    integer_class nf = max_abs_dense(f), ng = max_abs_dense(g);
+    integer_class B = 2 * (nf < ng ? nf : ng) + 29;
+    integer_class x = 99 * mp_sqrt(B);
+    if (B < x)
+        x = B;
+    integer_class lf = nf / mp_abs(f.back()), lg = ng / mp_abs(g.back());
+    integer_class y = 2 * (lf < lg ? lf : lg) + 2;
+    if (x < y)
+        x = y;
+
+    integer_class ff, gg, hh, cf;
+    for (unsigned i = 0; i < 6; i++) {
+        ff = eval_dense(f, x);
+        gg = eval_dense(g, x);
+        if (ff != 0 and gg != 0) {
+            mp_gcd(hh, ff, gg);
+            h = interpolate_dense(hh, x);
+            if (accept(h))
+                return true;
+            // the cofactors may interpolate correctly when the GCD does not
+            mp_divexact(cf, ff, hh);
+            h = interpolate_dense(cf, x);
+            make_primitive(h);
+            if (not h.empty() and divides_dense(h, f, cand) and accept(cand))
+                return true;
+            mp_divexact(cf, gg, hh);
+            h = interpolate_dense(cf, x);
+            make_primitive(h);
+            if (not h.empty() and divides_dense(h, g, cand) and accept(cand))
+                return true;
+        }
+        x = 73794 * x * mp_sqrt(mp_sqrt(x)) / 27011;
+    }
+    return false;
+}
+
+static uint64_t powmod_word(uint64_t a, uint64_t e, uint64_t p)
+{
+    uint64_t r = 1;
+    a %= p;
+    while (e > 0) {
+        if (e & 1)
+            r = r * a % p;
+        a = a * a % p;
+        e >>= 1;
+    }
+    return r;
+}
+
+static uint64_t mod_word(const integer_class &a, uint64_t p)
+{
+    integer_class t;
+    mp_fdiv_r(t, a, integer_class(static_cast<unsigned long>(p)));
+    return mp_get_ui(t);
+}
+
+static void strip_mod(std::vector<uint64_t> &a)
+{
+    while (not a.empty() and a.back() == 0)
+        a.pop_back();
+}
+
+// a := a mod b over GF(p), `b` nonzero
+static void rem_mod(std::vector<uint64_t> &a, const std::vector<uint64_t> &b,
+                    uint64_t p)
+{
+    const size_t db = b.size() - 1;
+    const uint64_t inv = powmod_word(b[db], p - 2, p);
+    while (a.size() > db) {
+        const uint64_t q = p - a.back() * inv % p;
+        const size_t s = a.size() - 1 - db;
+        for (size_t j = 0; j < db; j++)
+            a[s + j] = (a[s + j] + q * b[j]) % p;
+        a.pop_back();
+        strip_mod(a);
+    }
+}
+
+// monic GCD over GF(p)
+static std::vector<uint64_t> gcd_mod(std::vector<uint64_t> a,
+                                     std::vector<uint64_t> b, uint64_t p)
+{
+    while (not b.empty()) {
+        rem_mod(a, b, p);
+        std::swap(a, b);
+    }
+    const uint64_t inv = powmod_word(a.back(), p - 2, p);
+    for (auto &e : a)
+        e = e * inv % p;
+    return a;
+}
+
+UIntDict UIntDict::gcd_modular(const UIntDict &a, const UIntDict &b)
+{
+    vec_integer_class f, g, H, q;
+    integer_class c;
+    UIntDict res;
+    if (not gcd_prepare(a, b, f, g, c, res))
+        return res;
+
+    // the leading coefficient of the GCD divides `gamma`, so the modular
+    // images are scaled to have it as leading coefficient
+    integer_class gamma, m, M, half;
+    mp_gcd(gamma, f.back(), g.back());
+    size_t d = std::min(f.size(), g.size());
+    std::vector<uint64_t> fp(f.size()), gp(g.size()), hp;
+    // primes below 2**31, so that products of residues fit in 64 bits
+    uint64_t p = uint64_t(1) << 31;
+    while (true) {
+        do {
+            p--;
+        } while (not mp_probab_prime_p(
+            integer_class(static_cast<unsigned long>(p)), 25));
+        for (size_t i = 0; i < f.size(); i++)
+            fp[i] = mod_word(f[i], p);
+        for (size_t i = 0; i < g.size(); i++)
+            gp[i] = mod_word(g[i], p);
+        if (fp.back() == 0 or gp.back() == 0)
+            continue;
+        hp = gcd_mod(fp, gp, p);
+        if (hp.size() == 1)
+            return UIntDict(c);
+        // a larger degree means that `p` is unlucky, a smaller one that
+        // all the previous primes were. The first image can have the
+        // degree bound, when one input divides the other.
+        if (hp.size() > d)
+            continue;
+        const uint64_t gam = mod_word(gamma, p);
+        for (auto &e : hp)
+            e = e * gam % p;
+        if (H.empty() or hp.size() < d) {
+            d = hp.size();
+            H.resize(d);
+            for (size_t i = 0; i < d; i++) {
+                H[i] = static_cast<unsigned long>(hp[i]);
+                if (hp[i] > p / 2)
+                    H[i] -= static_cast<unsigned long>(p);
+            }
+            m = static_cast<unsigned long>(p);
+            continue;
+        }
+        // CRT in the symmetric range; once the image stops changing it is
+        // checked with trial division
+        const uint64_t minv = powmod_word(mod_word(m, p), p - 2, p);
+        M = m * static_cast<unsigned long>(p);
+        half = M / 2;
+        bool changed = false;
+        for (size_t i = 0; i < d; i++) {
+            const uint64_t u = (hp[i] + p - mod_word(H[i], p)) * minv % p;
+            if (u == 0)
+                continue;
+            changed = true;
+            H[i] += m * static_cast<unsigned long>(u);
+            if (H[i] > half)
+                H[i] -= M;
+        }
+        m = M;
+        if (not changed) {
+            vec_integer_class h = H;
+            make_primitive(h);
+            if (divides_dense(h, f, q) and divides_dense(h, g, q))
+                return gcd_finish(h, c);
+        }
+    }
+}
+
+bool UIntDict::divides(const UIntDict &a, const UIntDict &b, UIntDict &res)
+{
+    if (a.empty())
         return false;
+    vec_integer_class q;
+    if (not divides_dense(to_dense(a), to_dense(b), q))
+        return false;
+    res = from_dense(q);
+    return true;
+}
+
+// ------------------------------ Interpolation ------------------------------//
+// The interpolant is found modulo word primes with the subproduct tree
+// algorithm of GaloisFieldDict and recombined with CRT. Multipoint evaluation
+// over the integers is left to Horner's scheme: the values, and so the
+// remainders at every level of a subproduct tree, have about deg(f) log|x|
+// bits, which made the tree several times slower than Horner in practice.
+
+UIntDict UIntDict::interpolate(const vec_integer_class &x,
+                               const vec_integer_class &y)
+{
+    if (x.size() != y.size())
+        throw SymEngineException(
+            "interpolate: number of points and values must agree");
+    if (x.empty())
+        return UIntDict();
+    vec_integer_class sorted = x;
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+        throw SymEngineException("interpolate: points must be distinct");
+
+    // By Lagrange's formula an interpolant with integer coefficients has them
+    // bounded by sum |y_i| prod (1 + |x_j|)
+    integer_class bound(0);
+    for (const auto &e : y)
+        bound += mp_abs(e);
+    for (const auto &e : x)
+        bound *= 1 + mp_abs(e);
+
+    // The images modulo word primes are combined with CRT; once the result
+    // stops changing it is checked against the values
+    const size_t n = x.size();
+    vec_integer_class H(n), xp(n), yp(n);
+    std::vector<uint64_t> seen(n);
+    integer_class m(1), M, half;
+    uint64_t p = uint64_t(1) << 31;
+    while (true) {
+        do {
+            p--;
+        } while (not mp_probab_prime_p(
+            integer_class(static_cast<unsigned long>(p)), 25));
+        for (size_t i = 0; i < n; i++)
+            seen[i] = mod_word(x[i], p);
+        std::sort(seen.begin(), seen.end());
+        if (std::adjacent_find(seen.begin(), seen.end()) != seen.end())
+            continue;
+        const integer_class P(static_cast<unsigned long>(p));
+        for (size_t i = 0; i < n; i++) {
+            xp[i] = static_cast<unsigned long>(mod_word(x[i], p));
+            yp[i] = static_cast<unsigned long>(mod_word(y[i], p));
+        }
+        const GaloisFieldDict hp = GaloisFieldDict::gf_interpolate(xp, yp, P);
+        const uint64_t minv = powmod_word(mod_word(m, p), p - 2, p);
+        M = m * P;
+        half = M / 2;
+        bool changed = false;
+        for (size_t i = 0; i < n; i++) {
+            const uint64_t h = i < hp.dict_.size() ? mp_get_ui(hp.dict_[i]) : 0;
+            const uint64_t u = (h + p - mod_word(H[i], p)) * minv % p;
+            if (u == 0)
+                continue;
+            changed = true;
+            H[i] += m * static_cast<unsigned long>(u);
+            if (H[i] > half)
+                H[i] -= M;
+        }
+        const bool exhausted = M > 2 * bound;
+        const bool first = (m == 1);
+        m = M;
+        if ((changed or first) and not exhausted)
+            continue;
+        bool ok = true;
+        for (size_t i = 0; i < n and ok; i++)
+            ok = (eval_dense(H, x[i]) == y[i]);
+        if (ok)
+            return from_dense(H);
+        if (exhausted)
+            throw SymEngineException("interpolate: the interpolating "
+                                     "polynomial has non-integer coefficients");
     }
 }
 
+bool divides_upoly(const UIntPoly &a, const UIntPoly &b,
+                   const Ptr<RCP<const UIntPoly>> &out)
+{
+    if (!(a.get_var()->__eq__(*b.get_var())))
+        throw SymEngineException("Error: variables must agree.");
+
+    UIntDict res;
+    if (not UIntDict::divides(a.get_poly(), b.get_poly(), res))
+        return false;
+    *out = UIntPoly::from_container(a.get_var(), std::move(res));
+    return true;
+}
+
+RCP<const UIntPoly> gcd_upoly(const UIntPoly &a, const UIntPoly &b)
+{
+    if (!(a.get_var()->__eq__(*b.get_var())))
+        throw SymEngineException("Error: variables must agree.");
+    return UIntPoly::from_container(
+        a.get_var(), UIntDict::gcd(a.get_poly(), b.get_poly()));
+}
+
+RCP<const UIntPoly> lcm_upoly(const UIntPoly &a, const UIntPoly &b)
+{
+    if (!(a.get_var()->__eq__(*b.get_var())))
+        throw SymEngineException("Error: variables must agree.");
+    if (a.get_poly().empty() or b.get_poly().empty())
+        return UIntPoly::from_container(a.get_var(), UIntDict());
+    UIntDict g = UIntDict::gcd(a.get_poly(), b.get_poly()), q;
+    UIntDict::divides(g, a.get_poly(), q);
+    UIntDict res = q * b.get_poly();
+    if (res.get_lc() < 0)
+        res = -res;
+    return UIntPoly::from_container(a.get_var(), std::move(res));
+}
+
+RCP<const UIntPoly> interpolate_upoly(const RCP<const Basic> &var,
+                                      const vec_integer_class &x,
+                                      const vec_integer_class &y)
+{
+    return UIntPoly::from_container(var, UIntDict::interpolate(x, y));
+}
+
 } // namespace SymEngine
@@ -110,6 +110,28 @@ public:
         return curr;
     }
 
+    //! GCD of `a` and `b` with a positive leading coefficient, computed with
+    //! `gcd_heu` and falling back to `gcd_modular` if the heuristic fails
+    static UIntDict gcd(const UIntDict &a, const UIntDict &b);
+
+    //! Heuristic GCD (GCDHEU): `a` and `b` are evaluated at a large integer
+    //! and the integer GCD is interpolated back. Returns false if no
+    //! evaluation point gave a common divisor, `res` is undefined then.
+    static bool gcd_heu(const UIntDict &a, const UIntDict &b, UIntDict &res);
+
+    //! Multi-modular GCD: GCDs modulo word-size primes combined with CRT
+    //! until the result divides both `a` and `b`
+    static UIntDict gcd_modular(const UIntDict &a, const UIntDict &b);
+
+    //! true & sets `res` to b/a if a exactly divides b, otherwise false
+    static bool divides(const UIntDict &a, const UIntDict &b, UIntDict &res);
+
+    //! polynomial of degree less than the number of points taking the values
+    //! `y` at the distinct points `x`; throws if it has non-integer
+    //! coefficients
+    static UIntDict interpolate(const vec_integer_class &x,
+                                const vec_integer_class &y);
+
 }; // UIntDict
 
 class UIntPoly : public USymEnginePoly<UIntDict, UIntPolyBase, UIntPoly>
@@ -127,6 +149,14 @@ public:
 bool divides_upoly(const UIntPoly &a, const UIntPoly &b,
                    const Ptr<RCP<const UIntPoly>> &res);
 
+RCP<const UIntPoly> gcd_upoly(const UIntPoly &a, const UIntPoly &b);
+
+RCP<const UIntPoly> lcm_upoly(const UIntPoly &a, const UIntPoly &b);
+
+RCP<const UIntPoly> interpolate_upoly(const RCP<const Basic> &var,
+                                      const vec_integer_class &x,
+                                      const vec_integer_class &y);
+
 } // namespace SymEngine
 
 #endif
@@ -1,4 +1,5 @@
 #include <symengine/polys/uratpoly.h>
+#include <symengine/polys/uintpoly.h>
 
 namespace SymEngine
 {
@@ -29,31 +30,84 @@ bool divides_upoly(const URatPoly &a, const URatPoly &b,
     if (!(a.get_var()->__eq__(*b.get_var())))
         throw SymEngineException("Error: variables must agree.");
 
-    auto a_poly = a.get_poly();
-    auto b_poly = b.get_poly();
+    const URatDict &a_poly = a.get_poly();
+    const URatDict &b_poly = b.get_poly();
     if (a_poly.size() == 0)
         return false;
 
     map_uint_mpq res;
-    URatDict tmp;
-    rational_class q, r;
-    unsigned int a_deg, b_deg;
-
-    while (b_poly.size() >= a_poly.size()) {
-        a_deg = a_poly.degree();
-        b_deg = b_poly.degree();
-        q = b_poly.get_lc() / a_poly.get_lc();
-        res[b_deg - a_deg] = q;
-        URatDict tmp = URatDict(map_uint_mpq{{b_deg - a_deg, q}});
-        b_poly -= (a_poly * tmp);
+    if (not b_poly.empty()) {
+        const unsigned int a_deg = a_poly.degree(), b_deg = b_poly.degree();
+        if (b_deg < a_deg)
+            return false;
+        // dense long division, the remainder is left in the low part of `r`
+        std::vector<rational_class> ad(a_deg + 1), r(b_deg + 1);
+        for (const auto &it : a_poly.dict_)
+            ad[it.first] = it.second;
+        for (const auto &it : b_poly.dict_)
+            r[it.first] = it.second;
+        rational_class q;
+        for (unsigned int i = b_deg + 1; i-- > a_deg;) {
+            if (r[i] == 0)
+                continue;
+            q = r[i] / ad[a_deg];
+            for (unsigned int j = 0; j < a_deg; j++)
+                r[i - a_deg + j] -= q * ad[j];
+            res[i - a_deg] = q;
+        }
+        for (unsigned int i = 0; i < a_deg; i++) {
+            if (r[i] != 0)
+                return false;
+        }
     }
+    *out = URatPoly::from_dict(a.get_var(), std::move(res));
+    return true;
+}
 
-    if (b_poly.empty()) {
-        *out = URatPoly::from_dict(a.get_var(), std::move(res));
-        return true;
-    } else {
-        return false;
+// The integer polynomial with the same roots as `a`
+static UIntDict clear_denominators(const URatDict &a)
+{
+    integer_class l(1);
+    for (const auto &it : a.dict_)
+        mp_lcm(l, l, get_den(it.second));
+    UIntDict r;
+    for (const auto &it : a.dict_)
+        r.dict_[it.first] = get_num(it.second) * (l / get_den(it.second));
+    return r;
+}
+
+static URatDict make_monic(const UIntDict &a)
+{
+    URatDict r;
+    const integer_class lc = a.get_lc();
+    for (const auto &it : a.dict_) {
+        rational_class q(it.second, lc);
+        canonicalize(q);
+        r.dict_[it.first] = q;
     }
+    return r;
+}
+
+RCP<const URatPoly> gcd_upoly(const URatPoly &a, const URatPoly &b)
+{
+    if (!(a.get_var()->__eq__(*b.get_var())))
+        throw SymEngineException("Error: variables must agree.");
+    UIntDict g = UIntDict::gcd(clear_denominators(a.get_poly()),
+                               clear_denominators(b.get_poly()));
+    return URatPoly::from_container(a.get_var(), make_monic(g));
+}
+
+RCP<const URatPoly> lcm_upoly(const URatPoly &a, const URatPoly &b)
+{
+    if (!(a.get_var()->__eq__(*b.get_var())))
+        throw SymEngineException("Error: variables must agree.");
+    if (a.get_poly().empty() or b.get_poly().empty())
+        return URatPoly::from_container(a.get_var(), URatDict());
+    UIntDict ai = clear_denominators(a.get_poly()),
+             bi = clear_denominators(b.get_poly());
+    UIntDict g = UIntDict::gcd(ai, bi), q;
+    UIntDict::divides(g, ai, q);
+    return URatPoly::from_container(a.get_var(), make_monic(q * bi));
 }
 
 } // namespace SymEngine
@@ -50,6 +50,11 @@ public:
 bool divides_upoly(const URatPoly &a, const URatPoly &b,
                    const Ptr<RCP<const URatPoly>> &res);
 
+// monic GCD, computed over the integers with UIntDict::gcd
+RCP<const URatPoly> gcd_upoly(const URatPoly &a, const URatPoly &b);
+
+RCP<const URatPoly> lcm_upoly(const URatPoly &a, const URatPoly &b);
+
 } // namespace SymEngine
 
 #endif
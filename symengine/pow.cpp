@@ -106,7 +106,7 @@ RCP<const Basic> pow(const RCP<const Basic> &a, const RCP<const Basic> &b)
                    and rcp_static_cast<const Number>(b)->is_negative()) {
             return ComplexInf;
         } else {
-            return make_rcp<const Pow>(a, b);
+            return intern(make_rcp<const Pow>(a, b));
         }
     }
 
@@ -133,14 +133,14 @@ RCP<const Basic> pow(const RCP<const Basic> &a, const RCP<const Basic> &b)
                     return down_cast<const Rational &>(*b).rpowrat(
                         down_cast<const Integer &>(*a));
                 } else if (is_a<Complex>(*a)) {
-                    return make_rcp<const Pow>(a, b);
+                    return intern(make_rcp<const Pow>(a, b));
                 } else {
                     return down_cast<const Number &>(*a).pow(
                         *rcp_static_cast<const Number>(b));
                 }
             } else if (is_a<Complex>(*b)
                        and down_cast<const Number &>(*a).is_exact()) {
-                return make_rcp<const Pow>(a, b);
+                return intern(make_rcp<const Pow>(a, b));
             } else {
                 return down_cast<const Number &>(*a).pow(
                     *rcp_static_cast<const Number>(b));
@@ -172,7 +172,7 @@ RCP<const Basic> pow(const RCP<const Basic> &a, const RCP<const Basic> &b)
         RCP<const Pow> A = rcp_static_cast<const Pow>(a);
         return pow(A->get_base(), neg(b));
     }
-    return make_rcp<const Pow>(a, b);
+    return intern(make_rcp<const Pow>(a, b));
 }
 
 // This function can overflow, but it is fast.
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <limits>
 #include <symengine/printers/strprinter.h>
 
@@ -518,22 +519,35 @@ void StrPrinter::bvisit(const Add &x)
 {
     std::ostringstream o;
     bool first = true;
-    std::map<RCP<const Basic>, RCP<const Number>, PrinterBasicCmp> dict(
-        x.get_dict().begin(), x.get_dict().end());
+    // Sort pointers to the (coef, term) pairs instead of copying them
+    typedef std::pair<const RCP<const Number> *, const RCP<const Basic> *>
+        term_ptr;
+    std::vector<term_ptr> terms;
+    terms.reserve(x.get_dict().size());
+    x.for_each_term(
+        [&](const RCP<const Number> &coef, const RCP<const Basic> &term) {
+            terms.push_back({&coef, &term});
+        });
+    std::sort(terms.begin(), terms.end(),
+              [](const term_ptr &a, const term_ptr &b) {
+                  return PrinterBasicCmp()(*a.second, *b.second);
+              });
 
     if (neq(*(x.get_coef()), *zero)) {
         o << this->apply(x.get_coef());
         first = false;
     }
-    for (const auto &p : dict) {
+    for (const auto &p : terms) {
+        const RCP<const Number> &coef = *p.first;
+        const RCP<const Basic> &term = *p.second;
         std::string t;
-        if (eq(*(p.second), *one)) {
-            t = parenthesizeLT(p.first, PrecedenceEnum::Add);
-        } else if (eq(*(p.second), *minus_one)) {
-            t = "-" + parenthesizeLT(p.first, PrecedenceEnum::Mul);
+        if (eq(*coef, *one)) {
+            t = parenthesizeLT(term, PrecedenceEnum::Add);
+        } else if (eq(*coef, *minus_one)) {
+            t = "-" + parenthesizeLT(term, PrecedenceEnum::Mul);
         } else {
-            t = parenthesizeLT(p.second, PrecedenceEnum::Mul) + print_mul()
-                + parenthesizeLT(p.first, PrecedenceEnum::Mul);
+            t = parenthesizeLT(coef, PrecedenceEnum::Mul) + print_mul()
+                + parenthesizeLT(term, PrecedenceEnum::Mul);
         }
 
         if (not first) {
@@ -555,7 +569,11 @@ void StrPrinter::_print_pow(std::ostringstream &o, const RCP<const Basic> &a,
 {
     if (eq(*a, *E)) {
         o << "exp(" << apply(b) << ")";
-    } else if (eq(*b, *rational(1, 2))) {
+    } else if (is_a<Rational>(*b)
+               and get_num(down_cast<const Rational &>(*b).as_rational_class())
+                       == 1
+               and get_den(down_cast<const Rational &>(*b).as_rational_class())
+                       == 2) {
         o << "sqrt(" << apply(a) << ")";
     } else {
         o << parenthesizeLE(a, PrecedenceEnum::Pow);
@@ -1276,7 +1294,11 @@ void JuliaStrPrinter::_print_pow(std::ostringstream &o,
 {
     if (eq(*a, *E)) {
         o << "exp(" << apply(b) << ")";
-    } else if (eq(*b, *rational(1, 2))) {
+    } else if (is_a<Rational>(*b)
+               and get_num(down_cast<const Rational &>(*b).as_rational_class())
+                       == 1
+               and get_den(down_cast<const Rational &>(*b).as_rational_class())
+                       == 2) {
         o << "sqrt(" << apply(a) << ")";
     } else {
         o << parenthesizeLE(a, PrecedenceEnum::Pow);
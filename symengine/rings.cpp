@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
 #include <symengine/add.h>
 #include <symengine/pow.h>
 #include <symengine/rings.h>
@@ -104,4 +108,489 @@ void poly_mul(const umap_vec_mpz &A, const umap_vec_mpz &B, umap_vec_mpz &C)
     */
 }
 
+
+namespace
+{
+
+// Sparse polynomial with integer coefficients whose exponents are packed into
+// a single 64-bit word per monomial. The terms are kept sorted by decreasing
+// monomial, so that sums are merges and products are heap merges; neither
+// needs a hash table.
+template <class C>
+using packed_poly = std::vector<std::pair<uint64_t, C>>;
+
+// Coefficient arithmetic. The machine word versions return false on overflow,
+// in which case the whole computation is redone with `integer_class`.
+inline bool coef_set(long &r, const integer_class &i)
+{
+    if (not mp_fits_slong_p(i))
+        return false;
+    r = mp_get_si(i);
+    return true;
+}
+
+inline bool coef_set(integer_class &r, const integer_class &i)
+{
+    r = i;
+    return true;
+}
+
+inline bool coef_add(long &r, long a)
+{
+    if ((a > 0 and r > std::numeric_limits<long>::max() - a)
+        or (a < 0 and r < std::numeric_limits<long>::min() - a))
+        return false;
+    r += a;
+    return true;
+}
+
+inline bool coef_add(integer_class &r, const integer_class &a)
+{
+    r += a;
+    return true;
+}
+
+inline bool coef_mul(long &r, long a, long b)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return not __builtin_mul_overflow(a, b, &r);
+#else
+    const long limit = 1L << (std::numeric_limits<long>::digits / 2);
+    if (a >= limit or a <= -limit or b >= limit or b <= -limit)
+        return false;
+    r = a * b;
+    return true;
+#endif
+}
+
+inline bool coef_mul(integer_class &r, const integer_class &a,
+                     const integer_class &b)
+{
+    r = a * b;
+    return true;
+}
+
+inline bool coef_is_zero(long c)
+{
+    return c == 0;
+}
+
+inline bool coef_is_zero(const integer_class &c)
+{
+    return c == 0u;
+}
+
+//! Sorts the terms of `p` by decreasing monomial and combines equal ones
+template <class C>
+bool packed_normalize(packed_poly<C> &p)
+{
+    typedef std::pair<uint64_t, C> term;
+    std::sort(p.begin(), p.end(), [](const term &a, const term &b) {
+        return a.first > b.first;
+    });
+    size_t k = 0;
+    for (size_t i = 0; i < p.size();) {
+        if (k != i)
+            p[k] = std::move(p[i]);
+        for (i++; i < p.size() and p[i].first == p[k].first; i++) {
+            if (not coef_add(p[k].second, p[i].second))
+                return false;
+        }
+        if (not coef_is_zero(p[k].second))
+            k++;
+    }
+    p.resize(k);
+    return true;
+}
+
+//! `R = A + B`
+template <class C>
+bool packed_add(const packed_poly<C> &A, const packed_poly<C> &B,
+                packed_poly<C> &R)
+{
+    R.clear();
+    R.reserve(A.size() + B.size());
+    auto a = A.begin(), b = B.begin();
+    while (a != A.end() and b != B.end()) {
+        if (a->first > b->first) {
+            R.push_back(*a++);
+        } else if (a->first < b->first) {
+            R.push_back(*b++);
+        } else {
+            C c = a->second;
+            if (not coef_add(c, b->second))
+                return false;
+            if (not coef_is_zero(c))
+                R.push_back(std::make_pair(a->first, std::move(c)));
+            ++a;
+            ++b;
+        }
+    }
+    R.insert(R.end(), a, A.end());
+    R.insert(R.end(), b, B.end());
+    return true;
+}
+
+//! `R = A * B` by the heap method of Johnson as improved by Monagan and
+//! Pearce: the heap holds at most one product per term of A, and the result
+//! is produced in order, so each coefficient is accumulated in place.
+template <class C>
+bool packed_mul(const packed_poly<C> &A, const packed_poly<C> &B,
+                packed_poly<C> &R)
+{
+    R.clear();
+    if (A.empty() or B.empty())
+        return true;
+    if (A.size() > B.size())
+        return packed_mul(B, A, R);
+    struct Entry {
+        uint64_t m;
+        size_t i, j;
+        bool operator<(const Entry &o) const
+        {
+            return m < o.m;
+        }
+    };
+    std::vector<Entry> heap;
+    heap.reserve(A.size());
+    heap.push_back({A[0].first + B[0].first, 0, 0});
+    C c, t;
+    while (not heap.empty()) {
+        const uint64_t m = heap.front().m;
+        c = 0;
+        while (not heap.empty() and heap.front().m == m) {
+            Entry e = heap.front();
+            std::pop_heap(heap.begin(), heap.end());
+            heap.pop_back();
+            if (not coef_mul(t, A[e.i].second, B[e.j].second)
+                or not coef_add(c, t))
+                return false;
+            if (e.j == 0 and e.i + 1 < A.size()) {
+                heap.push_back({A[e.i + 1].first + B[0].first, e.i + 1, 0});
+                std::push_heap(heap.begin(), heap.end());
+            }
+            if (e.j + 1 < B.size()) {
+                heap.push_back({A[e.i].first + B[e.j + 1].first, e.i, e.j + 1});
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        if (not coef_is_zero(c))
+            R.push_back(std::make_pair(m, std::move(c)));
+    }
+    return true;
+}
+
+//! Number of bits needed to store the exponents `0..n`
+inline unsigned bit_length(unsigned n)
+{
+    unsigned b = 0;
+    for (; n != 0; n >>= 1)
+        b++;
+    return b;
+}
+
+bool packed_degree(const Basic &e, umap_basic_uint &index, vec_uint &deg,
+                   bool &work);
+
+//! Degree bounds of `base**exp`, see `packed_degree`
+bool packed_factor_degree(const Basic &base, const Basic &exp,
+                          umap_basic_uint &index, vec_uint &deg, bool &work)
+{
+    if (not is_a<Integer>(exp))
+        return false;
+    const integer_class &n = down_cast<const Integer &>(exp).as_integer_class();
+    if (mp_sign(n) < 0 or not mp_fits_ulong_p(n)
+        or mp_get_ui(n) > std::numeric_limits<unsigned>::max())
+        return false;
+    if (not packed_degree(base, index, deg, work))
+        return false;
+    for (auto &d : deg) {
+        unsigned long long b
+            = static_cast<unsigned long long>(d) * mp_get_ui(n);
+        if (b > std::numeric_limits<unsigned>::max())
+            return false;
+        d = static_cast<unsigned>(b);
+    }
+    return true;
+}
+
+//! Returns false unless `e` is a polynomial with integer coefficients built
+//! from symbols by `Add`, `Mul` and `Pow` with non-negative integer exponents,
+//! in at most 64 symbols. Otherwise `deg[index.at(s)]` receives an upper
+//! bound for the degree of the expansion of `e` in the symbol `s`, and `work`
+//! is set if `e` has a product or power of something other than a symbol,
+//! i.e. if expanding it does any real work.
+bool packed_degree(const Basic &e, umap_basic_uint &index, vec_uint &deg,
+                   bool &work)
+{
+    deg.clear();
+    if (is_a<Symbol>(e)) {
+        auto it = index.insert(std::make_pair(e.rcp_from_this(),
+                                              unsigned(index.size())))
+                      .first;
+        // Every symbol needs at least one bit
+        if (index.size() > 64)
+            return false;
+        deg.resize(it->second + 1);
+        deg[it->second] = 1;
+        return true;
+    }
+    if (is_a<Integer>(e))
+        return true;
+    vec_uint d;
+    if (is_a<Add>(e)) {
+        const Add &a = down_cast<const Add &>(e);
+        if (not is_a<Integer>(*a.get_coef()))
+            return false;
+        for (const auto &p : a.get_dict()) {
+            if (not is_a<Integer>(*p.second)
+                or not packed_degree(*p.first, index, d, work))
+                return false;
+            if (deg.size() < d.size())
+                deg.resize(d.size());
+            for (size_t i = 0; i < d.size(); i++)
+                deg[i] = std::max(deg[i], d[i]);
+        }
+        return true;
+    }
+    if (is_a<Mul>(e)) {
+        const Mul &m = down_cast<const Mul &>(e);
+        if (not is_a<Integer>(*m.get_coef()))
+            return false;
+        for (const auto &p : m.get_dict()) {
+            if (not is_a<Symbol>(*p.first))
+                work = true;
+            if (not packed_factor_degree(*p.first, *p.second, index, d, work))
+                return false;
+            if (deg.size() < d.size())
+                deg.resize(d.size());
+            for (size_t i = 0; i < d.size(); i++) {
+                if (deg[i] > std::numeric_limits<unsigned>::max() - d[i])
+                    return false;
+                deg[i] += d[i];
+            }
+        }
+        return true;
+    }
+    if (is_a<Pow>(e)) {
+        const Pow &p = down_cast<const Pow &>(e);
+        if (not is_a<Symbol>(*p.get_base()))
+            work = true;
+        return packed_factor_degree(*p.get_base(), *p.get_exp(), index, deg,
+                                    work);
+    }
+    return false;
+}
+
+//! Converts expressions accepted by `packed_degree` into packed polynomials,
+//! where the exponent of the symbol `s` lives in the bits starting at
+//! `shift[index.at(s)]`. Returns false if a coefficient does not fit in `C`.
+template <class C>
+class PackedExpander
+{
+private:
+    const umap_basic_uint &index_;
+    const vec_uint &shift_;
+    unsigned nthreads_;
+
+public:
+    PackedExpander(const umap_basic_uint &index, const vec_uint &shift,
+                   unsigned nthreads)
+        : index_(index), shift_(shift), nthreads_(nthreads)
+    {
+    }
+
+    bool convert(const Basic &e, packed_poly<C> &r) const
+    {
+        r.clear();
+        if (is_a<Symbol>(e)) {
+            r.push_back(std::make_pair(
+                uint64_t(1) << shift_[index_.at(e.rcp_from_this())], C(1)));
+            return true;
+        }
+        if (is_a<Integer>(e)) {
+            C c;
+            if (not coef_set(
+                    c, down_cast<const Integer &>(e).as_integer_class()))
+                return false;
+            if (not coef_is_zero(c))
+                r.push_back(std::make_pair(uint64_t(0), std::move(c)));
+            return true;
+        }
+        packed_poly<C> t, s;
+        if (is_a<Add>(e)) {
+            const Add &a = down_cast<const Add &>(e);
+            if (not convert(*a.get_coef(), r))
+                return false;
+            C c;
+            for (const auto &p : a.get_dict()) {
+                if (not convert(*p.first, t)
+                    or not coef_set(c, down_cast<const Integer &>(*p.second)
+                                           .as_integer_class()))
+                    return false;
+                for (auto &q : t) {
+                    C u;
+                    if (not coef_mul(u, q.second, c))
+                        return false;
+                    r.push_back(std::make_pair(q.first, std::move(u)));
+                }
+            }
+            return packed_normalize(r);
+        }
+        if (is_a<Mul>(e)) {
+            const Mul &m = down_cast<const Mul &>(e);
+            if (not convert(*m.get_coef(), r))
+                return false;
+            for (const auto &p : m.get_dict()) {
+                if (not pow(*p.first, *p.second, t) or not mul(r, t, s))
+                    return false;
+                std::swap(r, s);
+            }
+            return true;
+        }
+        SYMENGINE_ASSERT(is_a<Pow>(e))
+        const Pow &p = down_cast<const Pow &>(e);
+        return pow(*p.get_base(), *p.get_exp(), r);
+    }
+
+    //! `r = base**exp`, by repeated multiplication with `base`, which is
+    //! cheaper than squaring as `base` is usually much smaller than `r`
+    bool pow(const Basic &base, const Basic &exp, packed_poly<C> &r) const
+    {
+        unsigned long n
+            = mp_get_ui(down_cast<const Integer &>(exp).as_integer_class());
+        packed_poly<C> b, t;
+        if (n == 0) {
+            r.clear();
+            r.push_back(std::make_pair(uint64_t(0), C(1)));
+            return true;
+        }
+        if (not convert(base, b))
+            return false;
+        if (b.size() == 1) {
+            // A single term only needs its coefficient raised to `n`, by
+            // binary powering unless it is a unit
+            C c(1), s = b[0].second, u;
+            if (s == 1 or s == -1) {
+                if (n % 2 == 1)
+                    c = s;
+            } else {
+                for (unsigned long k = n;; k >>= 1) {
+                    if (k % 2 == 1) {
+                        if (not coef_mul(u, c, s))
+                            return false;
+                        std::swap(c, u);
+                    }
+                    if (k == 1)
+                        break;
+                    if (not coef_mul(u, s, s))
+                        return false;
+                    std::swap(s, u);
+                }
+            }
+            r.clear();
+            r.push_back(std::make_pair(b[0].first * n, std::move(c)));
+            return true;
+        }
+        r = b;
+        for (unsigned long i = 1; i < n; i++) {
+            if (not mul(r, b, t))
+                return false;
+            std::swap(r, t);
+        }
+        return true;
+    }
+
+    //! `R = A * B`, splitting the larger factor between threads if requested
+    bool mul(const packed_poly<C> &A, const packed_poly<C> &B,
+             packed_poly<C> &R) const
+    {
+#if defined(_OPENMP)
+        const packed_poly<C> &L = A.size() >= B.size() ? A : B;
+        const packed_poly<C> &S = A.size() >= B.size() ? B : A;
+        if (nthreads_ > 1 and L.size() >= 64 * nthreads_) {
+            const int n = static_cast<int>(nthreads_);
+            std::vector<packed_poly<C>> parts(n);
+            bool ok = true;
+#pragma omp parallel for num_threads(n) reduction(&& : ok)
+            for (int k = 0; k < n; k++) {
+                packed_poly<C> chunk(L.begin() + L.size() * k / n,
+                                     L.begin() + L.size() * (k + 1) / n);
+                ok = packed_mul(chunk, S, parts[k]) and ok;
+            }
+            if (not ok)
+                return false;
+            R = std::move(parts[0]);
+            packed_poly<C> t;
+            for (int k = 1; k < n; k++) {
+                if (not packed_add(R, parts[k], t))
+                    return false;
+                std::swap(R, t);
+            }
+            return true;
+        }
+#endif
+        return packed_mul(A, B, R);
+    }
+};
+
+template <class C>
+bool packed_expand_impl(const RCP<const Basic> &p, const umap_basic_uint &index,
+                        const vec_uint &shift, const vec_uint &deg,
+                        unsigned nthreads, const Ptr<RCP<const Basic>> &result)
+{
+    packed_poly<C> r;
+    if (not PackedExpander<C>(index, shift, nthreads).convert(*p, r))
+        return false;
+
+    std::vector<std::tuple<RCP<const Basic>, unsigned, uint64_t>> fields;
+    for (const auto &s : index) {
+        if (deg[s.second] != 0)
+            fields.push_back(std::make_tuple(
+                s.first, shift[s.second],
+                (uint64_t(1) << bit_length(deg[s.second])) - 1));
+    }
+    umap_basic_num d;
+    RCP<const Number> coef = zero;
+    for (auto &t : r) {
+        if (t.first == 0) {
+            coef = integer(std::move(t.second));
+            continue;
+        }
+        map_basic_basic m;
+        for (const auto &f : fields) {
+            uint64_t e = (t.first >> std::get<1>(f)) & std::get<2>(f);
+            if (e != 0)
+                m[std::get<0>(f)] = integer(static_cast<unsigned long>(e));
+        }
+        d[Mul::from_dict(one, std::move(m))] = integer(std::move(t.second));
+    }
+    *result = Add::from_dict(coef, std::move(d));
+    return true;
+}
+
+} // namespace
+
+bool packed_expand(const RCP<const Basic> &p,
+                   const Ptr<RCP<const Basic>> &result, unsigned nthreads)
+{
+    umap_basic_uint index;
+    vec_uint deg, shift;
+    bool work = false;
+    if (not packed_degree(*p, index, deg, work) or not work)
+        return false;
+    deg.resize(index.size());
+    shift.resize(index.size());
+    unsigned bits = 0;
+    for (size_t i = 0; i < deg.size(); i++) {
+        shift[i] = bits;
+        bits += bit_length(deg[i]);
+        if (bits > 64)
+            return false;
+    }
+    return packed_expand_impl<long>(p, index, shift, deg, nthreads, result)
+           or packed_expand_impl<integer_class>(p, index, shift, deg, nthreads,
+                                                result);
+}
+
 } // namespace SymEngine
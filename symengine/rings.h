@@ -18,6 +18,15 @@ void expr2poly(const RCP<const Basic> &p, umap_basic_num &syms,
 //! Multiply two polynomials: `C = A*B`
 void poly_mul(const umap_vec_mpz &A, const umap_vec_mpz &B, umap_vec_mpz &C);
 
+//! Expands `p` if it is a polynomial with integer coefficients in symbols whose
+//! degrees fit together into 64 bits. The multiplications are done on sorted
+//! arrays of monomials with exponents packed into one machine word, and with
+//! machine word coefficients as long as they do not overflow. Returns false,
+//! leaving `result` untouched, if `p` is not such a polynomial or if there is
+//! nothing to expand, so that `expand()` can fall back to the generic code.
+bool packed_expand(const RCP<const Basic> &p,
+                   const Ptr<RCP<const Basic>> &result, unsigned nthreads = 1);
+
 } // namespace SymEngine
 
 #endif
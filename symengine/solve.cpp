@@ -592,6 +592,46 @@ set_basic get_set_from_vec(const vec_sym &syms)
     return sb;
 }
 
+// Coefficients of the symbols `gens` in the linear equation `eqn` and the
+// right hand side, `gens` must contain all the symbols of `eqn` that are
+// unknowns
+static void linear_eqn_coeffs(const RCP<const Basic> &eqn, set_basic &gens,
+                              const umap_basic_uint &index_of_sym,
+                              std::vector<unsigned> &cols, vec_basic &coeffs,
+                              RCP<const Basic> &rhs)
+{
+    auto neqn = eqn;
+    if (is_a<Equality>(*eqn)) {
+        neqn = sub(down_cast<const Equality &>(*eqn).get_arg2(),
+                   down_cast<const Equality &>(*eqn).get_arg1());
+    }
+
+    auto mpoly = from_basic<MExprPoly>(neqn, gens);
+    RCP<const Basic> rem = zero;
+    for (const auto &p : mpoly->get_poly().dict_) {
+        RCP<const Basic> res = (p.second.get_basic());
+        int whichvar = 0, non_zero = 0;
+        RCP<const Basic> cursim;
+        for (auto &sym : gens) {
+            if (0 != p.first[whichvar]) {
+                non_zero++;
+                cursim = sym;
+                if (p.first[whichvar] != 1 or non_zero == 2) {
+                    throw SymEngineException("Expected a linear equation.");
+                }
+            }
+            whichvar++;
+        }
+        if (not non_zero) {
+            rem = res;
+        } else {
+            cols.push_back(index_of_sym.find(cursim)->second);
+            coeffs.push_back(res);
+        }
+    }
+    rhs = neg(rem);
+}
+
 std::pair<DenseMatrix, DenseMatrix>
 linear_eqns_to_matrix(const vec_basic &equations, const vec_sym &syms)
 {
@@ -607,38 +647,68 @@ linear_eqns_to_matrix(const vec_basic &equations, const vec_sym &syms)
         index_of_sym[syms[i]] = i;
     }
     for (const auto &eqn : equations) {
-        auto neqn = eqn;
-        if (is_a<Equality>(*eqn)) {
-            neqn = sub(down_cast<const Equality &>(*eqn).get_arg2(),
-                       down_cast<const Equality &>(*eqn).get_arg1());
+        std::vector<unsigned> cols;
+        vec_basic coeffs;
+        RCP<const Basic> rhs;
+        linear_eqn_coeffs(eqn, gens, index_of_sym, cols, coeffs, rhs);
+        for (unsigned i = 0; i < cols.size(); i++) {
+            A.set(row, cols[i], coeffs[i]);
         }
-
-        auto mpoly = from_basic<MExprPoly>(neqn, gens);
-        RCP<const Basic> rem = zero;
-        for (const auto &p : mpoly->get_poly().dict_) {
-            RCP<const Basic> res = (p.second.get_basic());
-            int whichvar = 0, non_zero = 0;
-            RCP<const Basic> cursim;
-            for (auto &sym : gens) {
-                if (0 != p.first[whichvar]) {
-                    non_zero++;
-                    cursim = sym;
-                    if (p.first[whichvar] != 1 or non_zero == 2) {
-                        throw SymEngineException("Expected a linear equation.");
-                    }
-                }
-                whichvar++;
-            }
-            if (not non_zero) {
-                rem = res;
-            } else {
-                A.set(row, index_of_sym[cursim], res);
-            }
-        }
-        bvec.push_back(neg(rem));
+        bvec.push_back(rhs);
         ++row;
     }
     return std::make_pair(
         A, DenseMatrix(numeric_cast<unsigned int>(equations.size()), 1, bvec));
 }
+
+std::pair<CSRMatrix, DenseMatrix>
+linear_eqns_to_sparse_matrix(const vec_basic &equations, const vec_sym &syms)
+{
+    auto size = numeric_cast<unsigned int>(syms.size());
+    auto neqns = numeric_cast<unsigned int>(equations.size());
+    std::vector<unsigned> is, js;
+    vec_basic xs, bvec;
+
+    umap_basic_uint index_of_sym;
+    for (unsigned int i = 0; i < size; i++) {
+        index_of_sym[syms[i]] = i;
+    }
+    for (unsigned row = 0; row < neqns; row++) {
+        // Only the unknowns that appear in the equation are generators
+        set_basic gens;
+        for (const auto &s : free_symbols(*equations[row])) {
+            if (index_of_sym.find(s) != index_of_sym.end()) {
+                gens.insert(s);
+            }
+        }
+        vec_basic coeffs;
+        RCP<const Basic> rhs;
+        size_t start = js.size();
+        linear_eqn_coeffs(equations[row], gens, index_of_sym, js, coeffs, rhs);
+        is.resize(js.size(), row);
+        for (size_t i = start; i < js.size(); i++) {
+            xs.push_back(coeffs[i - start]);
+        }
+        bvec.push_back(rhs);
+    }
+    return std::make_pair(CSRMatrix::from_coo(neqns, size, is, js, xs),
+                          DenseMatrix(neqns, 1, bvec));
+}
+
+vec_basic linsolve(const CSRMatrix &A, const DenseMatrix &b)
+{
+    DenseMatrix res(A.ncols(), 1);
+    A.LU_solve(b, res);
+    vec_basic fs;
+    for (unsigned i = 0; i < res.nrows(); i++) {
+        fs.push_back(res.get(i, 0));
+    }
+    return fs;
+}
+
+vec_basic sparse_linsolve(const vec_basic &system, const vec_sym &syms)
+{
+    auto mat = linear_eqns_to_sparse_matrix(system, syms);
+    return linsolve(mat.first, mat.second);
+}
 } // namespace SymEngine
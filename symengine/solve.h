@@ -98,6 +98,17 @@ vec_basic linsolve(const vec_basic &system, const vec_sym &syms);
 // first Matrix is for `A` and second one is for `b`.
 std::pair<DenseMatrix, DenseMatrix>
 linear_eqns_to_matrix(const vec_basic &equations, const vec_sym &syms);
+
+// Sparse variant of `linear_eqns_to_matrix`, `A` is stored in CSR form.
+std::pair<CSRMatrix, DenseMatrix>
+linear_eqns_to_sparse_matrix(const vec_basic &equations, const vec_sym &syms);
+
+// Solves `Ax=b` for a sparse `A` using its sparse LU factorization.
+vec_basic linsolve(const CSRMatrix &A, const DenseMatrix &b);
+
+// Input as a vector of linear equations, solved without forming a dense
+// matrix.
+vec_basic sparse_linsolve(const vec_basic &system, const vec_sym &syms);
 } // namespace SymEngine
 
 #endif // SYMENGINE_SOLVE_H
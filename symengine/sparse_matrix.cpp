@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <map>
 #include <numeric>
+#include <set>
 #include <symengine/matrix.h>
 #include <symengine/add.h>
 #include <symengine/functions.h>
@@ -7,9 +10,39 @@
 #include <symengine/symengine_exception.h>
 #include <symengine/visitor.h>
 #include <symengine/test_visitors.h>
+#include <symengine/polys/cancel.h>
 
 namespace SymEngine
 {
+// Puts `e` over a common denominator with expanded numerator and
+// denominator, cancelling their GCD when both are polynomials with integer
+// coefficients. Without it an entry that cancels to zero is not recognised,
+// and the nested quotients grow with every elimination step.
+static RCP<const Basic> csr_normalize(const RCP<const Basic> &e)
+{
+    if (is_a_Number(*e)) {
+        return e;
+    }
+    RCP<const Basic> num, den;
+    as_numer_denom(e, outArg(num), outArg(den));
+    num = expand(num);
+    if (is_number_and_zero(*num)) {
+        return zero;
+    }
+    den = expand(den);
+    if (not is_a_Number(*den)) {
+        try {
+            RCP<const MIntPoly> n, d, g;
+            cancel(num, den, outArg(n), outArg(d), outArg(g));
+            num = n->as_symbolic();
+            den = d->as_symbolic();
+        } catch (SymEngineException &) {
+            // Not polynomials with integer coefficients, keep the fraction
+        }
+    }
+    return div(num, den);
+}
+
 // ----------------------------- CSRMatrix ------------------------------------
 CSRMatrix::CSRMatrix() {}
 
@@ -174,27 +207,124 @@ tribool CSRMatrix::is_real(const Assumptions *assumptions) const
 
 unsigned CSRMatrix::rank() const
 {
-    throw NotImplementedError("Not Implemented");
+    CSRMatrix L, U;
+    std::vector<unsigned> p, q;
+    return csr_LU(*this, L, U, p, q, true);
 }
 
 RCP<const Basic> CSRMatrix::det() const
 {
-    throw NotImplementedError("Not Implemented");
+    SYMENGINE_ASSERT(row_ == col_);
+    CSRMatrix L, U;
+    std::vector<unsigned> p, q;
+    if (csr_LU(*this, L, U, p, q, true) < row_) {
+        return zero;
+    }
+    // The pivots are the first entries of the rows of U
+    vec_basic factors;
+    for (unsigned i = 0; i < row_; i++) {
+        factors.push_back(U.x_[U.p_[i]]);
+    }
+    // Sign of the permutations from their number of cycles
+    unsigned transpositions = 0;
+    for (const auto *perm : {&p, &q}) {
+        std::vector<bool> visited(row_, false);
+        for (unsigned i = 0; i < row_; i++) {
+            if (visited[i]) {
+                continue;
+            }
+            for (unsigned j = i; not visited[j]; j = (*perm)[j]) {
+                visited[j] = true;
+                transpositions++;
+            }
+            transpositions--;
+        }
+    }
+    if (transpositions % 2 == 1) {
+        factors.push_back(minus_one);
+    }
+    return csr_normalize(SymEngine::mul(factors));
 }
 
 void CSRMatrix::inv(MatrixBase &result) const
 {
-    throw NotImplementedError("Not Implemented");
+    SYMENGINE_ASSERT(row_ == col_ and result.nrows() == row_
+                     and result.ncols() == col_);
+    DenseMatrix I(row_, col_), X(row_, col_);
+    eye(I);
+    LU_solve(I, X);
+    if (is_a<DenseMatrix>(result)) {
+        down_cast<DenseMatrix &>(result) = X;
+    } else if (is_a<CSRMatrix>(result)) {
+        std::vector<unsigned> p(1, 0), j;
+        vec_basic x;
+        for (unsigned ri = 0; ri < row_; ri++) {
+            for (unsigned ci = 0; ci < col_; ci++) {
+                RCP<const Basic> e = X.get(ri, ci);
+                if (not is_true(is_zero(*e))) {
+                    j.push_back(ci);
+                    x.push_back(e);
+                }
+            }
+            p.push_back(static_cast<unsigned>(j.size()));
+        }
+        down_cast<CSRMatrix &>(result) = CSRMatrix(
+            row_, col_, std::move(p), std::move(j), std::move(x));
+    } else {
+        throw NotImplementedError("Not Implemented");
+    }
 }
 
 void CSRMatrix::add_matrix(const MatrixBase &other, MatrixBase &result) const
 {
-    throw NotImplementedError("Not Implemented");
+    SYMENGINE_ASSERT(row_ == result.nrows() and col_ == result.ncols());
+    if (is_a<CSRMatrix>(other) and is_a<CSRMatrix>(result)) {
+        auto &o = down_cast<const CSRMatrix &>(other);
+        auto &r = down_cast<CSRMatrix &>(result);
+        CSRMatrix C(row_, col_);
+        csr_binop_csr_canonical(*this, o, C, SymEngine::add);
+        r = std::move(C);
+    } else {
+        throw NotImplementedError("Not Implemented");
+    }
 }
 
 void CSRMatrix::mul_matrix(const MatrixBase &other, MatrixBase &result) const
 {
-    throw NotImplementedError("Not Implemented");
+    SYMENGINE_ASSERT(col_ == other.nrows() and row_ == result.nrows()
+                     and other.ncols() == result.ncols());
+    if (is_a<CSRMatrix>(other) and is_a<CSRMatrix>(result)) {
+        auto &o = down_cast<const CSRMatrix &>(other);
+        auto &r = down_cast<CSRMatrix &>(result);
+        CSRMatrix C(row_, o.col_);
+        csr_matmat_pass1(*this, o, C);
+        C.j_.resize(C.p_[row_]);
+        C.x_.resize(C.p_[row_]);
+        csr_matmat_pass2(*this, o, C);
+        C.j_.resize(C.p_[row_]);
+        C.x_.resize(C.p_[row_]);
+        if (not csr_has_sorted_indices(C.p_, C.j_, row_)) {
+            csr_sort_indices(C.p_, C.j_, C.x_, row_);
+        }
+        r = std::move(C);
+    } else if (is_a<DenseMatrix>(other) and is_a<DenseMatrix>(result)) {
+        auto &o = down_cast<const DenseMatrix &>(other);
+        auto &r = down_cast<DenseMatrix &>(result);
+        const unsigned ncols = o.ncols();
+        DenseMatrix C(row_, ncols);
+        for (unsigned ri = 0; ri < row_; ri++) {
+            for (unsigned ci = 0; ci < ncols; ci++) {
+                vec_basic terms;
+                for (unsigned k = p_[ri]; k < p_[ri + 1]; k++) {
+                    terms.push_back(SymEngine::mul(x_[k], o.get(j_[k], ci)));
+                }
+                C.set(ri, ci, SymEngine::add(terms));
+            }
+        }
+        r = C;
+    } else {
+        throw NotImplementedError("Not Implemented");
+    }
 }
 
 void CSRMatrix::elementwise_mul_matrix(const MatrixBase &other,
@@ -295,7 +425,19 @@ void CSRMatrix::submatrix(MatrixBase &result, unsigned row_start,
 // LU factorization
 void CSRMatrix::LU(MatrixBase &L, MatrixBase &U) const
 {
-    throw NotImplementedError("Not Implemented");
+    if (is_a<CSRMatrix>(L) and is_a<CSRMatrix>(U)) {
+        std::vector<unsigned> p, q;
+        csr_LU(*this, down_cast<CSRMatrix &>(L), down_cast<CSRMatrix &>(U), p,
+               q, false);
+        for (unsigned i = 0; i < row_; i++) {
+            if (p[i] != i or q[i] != i) {
+                throw SymEngineException(
+                    "LU decomposition requires pivoting, use csr_LU");
+            }
+        }
+    } else {
+        throw NotImplementedError("Not Implemented");
+    }
 }
 
 // LDL factorization
@@ -307,7 +449,51 @@ void CSRMatrix::LDL(MatrixBase &L, MatrixBase &D) const
 // Solve Ax = b using LU factorization
 void CSRMatrix::LU_solve(const MatrixBase &b, MatrixBase &x) const
 {
-    throw NotImplementedError("Not Implemented");
+    SYMENGINE_ASSERT(row_ == col_ and b.nrows() == row_
+                     and x.nrows() == col_ and x.ncols() == b.ncols());
+    if (not is_a<DenseMatrix>(b) or not is_a<DenseMatrix>(x)) {
+        throw NotImplementedError("Not Implemented");
+    }
+    auto &b_ = down_cast<const DenseMatrix &>(b);
+    auto &x_ = down_cast<DenseMatrix &>(x);
+
+    CSRMatrix L, U;
+    std::vector<unsigned> p, q;
+    if (csr_LU(*this, L, U, p, q, true) < row_) {
+        throw SymEngineException("Matrix is singular");
+    }
+
+    const unsigned n = row_;
+    vec_basic y(n);
+    for (unsigned k = 0; k < b_.ncols(); k++) {
+        // L y = P b
+        for (unsigned i = 0; i < n; i++) {
+            vec_basic terms{b_.get(p[i], k)};
+            for (unsigned jj = L.p_[i]; jj < L.p_[i + 1] - 1; jj++) {
+                if (not is_number_and_zero(*y[L.j_[jj]])) {
+                    terms.push_back(
+                        SymEngine::mul(minus_one,
+                                       SymEngine::mul(L.x_[jj], y[L.j_[jj]])));
+                }
+            }
+            y[i] = SymEngine::add(terms);
+        }
+        // U z = y, x = Q z
+        for (unsigned i = n; i-- > 0;) {
+            vec_basic terms{y[i]};
+            for (unsigned jj = U.p_[i] + 1; jj < U.p_[i + 1]; jj++) {
+                if (not is_number_and_zero(*y[U.j_[jj]])) {
+                    terms.push_back(
+                        SymEngine::mul(minus_one,
+                                       SymEngine::mul(U.x_[jj], y[U.j_[jj]])));
+                }
+            }
+            y[i] = csr_normalize(div(SymEngine::add(terms), U.x_[U.p_[i]]));
+        }
+        for (unsigned i = 0; i < n; i++) {
+            x_.set(q[i], k, y[i]);
+        }
+    }
 }
 
 // Fraction free LU factorization
@@ -488,29 +674,93 @@ CSRMatrix CSRMatrix::from_coo(unsigned row, unsigned col,
     return B;
 }
 
-CSRMatrix CSRMatrix::jacobian(const vec_basic &exprs, const vec_sym &x,
-                              bool diff_cache)
+void CSRMatrix::jacobian_sparsity(const vec_basic &exprs, const vec_sym &x,
+                                  std::vector<unsigned> &p,
+                                  std::vector<unsigned> &j)
 {
     const unsigned nrows = static_cast<unsigned>(exprs.size());
     const unsigned ncols = static_cast<unsigned>(x.size());
-    std::vector<unsigned> p(1, 0), j;
-    vec_basic elems;
+    // Column of the first occurrence of each symbol, `next` links the
+    // columns of a symbol that appears several times in `x`
+    umap_basic_uint column;
+    std::vector<unsigned> next(ncols, ncols);
+    for (unsigned ci = ncols; ci-- > 0;) {
+        auto it = column.find(x[ci]);
+        if (it != column.end()) {
+            next[ci] = it->second;
+            it->second = ci;
+        } else {
+            column.insert({x[ci], ci});
+        }
+    }
+
+    std::vector<std::vector<unsigned>> cols(nrows);
+#pragma omp parallel for
+    for (unsigned ri = 0; ri < nrows; ++ri) {
+        for (const auto &s : free_symbols(*exprs[ri])) {
+            auto it = column.find(s);
+            if (it != column.end()) {
+                for (unsigned ci = it->second; ci < ncols; ci = next[ci]) {
+                    cols[ri].push_back(ci);
+                }
+            }
+        }
+        std::sort(cols[ri].begin(), cols[ri].end());
+    }
+
+    p.assign(1, 0);
     p.reserve(nrows + 1);
-    j.reserve(nrows);
-    elems.reserve(nrows);
+    j.clear();
+    for (unsigned ri = 0; ri < nrows; ++ri) {
+        j.insert(j.end(), cols[ri].begin(), cols[ri].end());
+        p.push_back(static_cast<unsigned>(j.size()));
+    }
+}
+
+CSRMatrix CSRMatrix::jacobian(const vec_basic &exprs, const vec_sym &x,
+                              const std::vector<unsigned> &p,
+                              const std::vector<unsigned> &j, bool diff_cache)
+{
+    const unsigned nrows = static_cast<unsigned>(exprs.size());
+    const unsigned ncols = static_cast<unsigned>(x.size());
+    SYMENGINE_ASSERT(p.size() == nrows + 1 and p.back() == j.size());
+    vec_basic elems(j.size());
+#pragma omp parallel for
     for (unsigned ri = 0; ri < nrows; ++ri) {
-        p.push_back(p.back());
-        for (unsigned ci = 0; ci < ncols; ++ci) {
-            auto elem = exprs[ri]->diff(x[ci], diff_cache);
-            if (!is_true(is_zero(*elem))) {
-                p.back()++;
-                j.push_back(ci);
-                elems.emplace_back(std::move(elem));
+        for (unsigned k = p[ri]; k < p[ri + 1]; ++k) {
+            elems[k] = exprs[ri]->diff(x[j[k]], diff_cache);
+        }
+    }
+    return CSRMatrix(nrows, ncols, std::vector<unsigned>(p),
+                     std::vector<unsigned>(j), std::move(elems));
+}
+
+CSRMatrix CSRMatrix::jacobian(const vec_basic &exprs, const vec_sym &x,
+                              bool diff_cache)
+{
+    // Only the symbols that appear in an expression can give a nonzero
+    // derivative
+    std::vector<unsigned> p, j;
+    jacobian_sparsity(exprs, x, p, j);
+    CSRMatrix J = CSRMatrix::jacobian(exprs, x, p, j, diff_cache);
+
+    // Drop the entries that still turn out to be zero
+    unsigned nnz = 0;
+    for (unsigned ri = 0; ri < J.row_; ++ri) {
+        unsigned k = J.p_[ri];
+        J.p_[ri] = nnz;
+        for (; k < J.p_[ri + 1]; ++k) {
+            if (!is_true(is_zero(*J.x_[k]))) {
+                J.j_[nnz] = J.j_[k];
+                J.x_[nnz] = std::move(J.x_[k]);
+                nnz++;
             }
         }
     }
-    return CSRMatrix(nrows, ncols, std::move(p), std::move(j),
-                     std::move(elems));
+    J.p_[J.row_] = nnz;
+    J.j_.resize(nnz);
+    J.x_.resize(nnz);
+    return J;
 }
 
 CSRMatrix CSRMatrix::jacobian(const DenseMatrix &A, const DenseMatrix &x,
@@ -532,7 +782,7 @@ CSRMatrix CSRMatrix::jacobian(const DenseMatrix &A, const DenseMatrix &x,
 void csr_matmat_pass1(const CSRMatrix &A, const CSRMatrix &B, CSRMatrix &C)
 {
     // method that uses O(n) temp storage
-    std::vector<unsigned> mask(A.col_, -1);
+    std::vector<unsigned> mask(B.col_, -1);
     C.p_[0] = 0;
 
     unsigned nnz = 0;
@@ -567,8 +817,8 @@ void csr_matmat_pass1(const CSRMatrix &A, const CSRMatrix &B, CSRMatrix &C)
 // row pointer Cp[] computed in Pass 1.
 void csr_matmat_pass2(const CSRMatrix &A, const CSRMatrix &B, CSRMatrix &C)
 {
-    std::vector<int> next(A.col_, -1);
-    vec_basic sums(A.col_, zero);
+    std::vector<int> next(B.col_, -1);
+    vec_basic sums(B.col_, zero);
 
     unsigned nnz = 0;
 
@@ -770,4 +1020,186 @@ void csr_binop_csr_canonical(
         CSRMatrix::csr_sum_duplicates(C.p_, C.j_, C.x_, A.row_);
 }
 
+std::vector<unsigned> csr_minimum_degree_ordering(const CSRMatrix &A)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_);
+    const unsigned n = A.row_;
+    // Graph of A + A^T
+    std::vector<std::set<unsigned>> adj(n);
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned jj = A.p_[i]; jj < A.p_[i + 1]; jj++) {
+            if (A.j_[jj] != i) {
+                adj[i].insert(A.j_[jj]);
+                adj[A.j_[jj]].insert(i);
+            }
+        }
+    }
+
+    // Nodes by (degree, index)
+    std::set<std::pair<unsigned, unsigned>> queue;
+    for (unsigned i = 0; i < n; i++) {
+        queue.insert({static_cast<unsigned>(adj[i].size()), i});
+    }
+
+    std::vector<unsigned> order;
+    order.reserve(n);
+    while (not queue.empty()) {
+        const unsigned v = queue.begin()->second;
+        queue.erase(queue.begin());
+        order.push_back(v);
+        // Eliminating `v` connects all of its neighbours
+        std::vector<unsigned> nbrs(adj[v].begin(), adj[v].end());
+        for (unsigned u : nbrs) {
+            queue.erase({static_cast<unsigned>(adj[u].size()), u});
+            adj[u].erase(v);
+            adj[u].insert(nbrs.begin(), nbrs.end());
+            adj[u].erase(u);
+            queue.insert({static_cast<unsigned>(adj[u].size()), u});
+        }
+        adj[v].clear();
+    }
+    return order;
+}
+
+unsigned csr_LU(const CSRMatrix &A, CSRMatrix &L, CSRMatrix &U,
+                std::vector<unsigned> &p, std::vector<unsigned> &q,
+                bool reorder)
+{
+    const unsigned nrows = A.row_, ncols = A.col_;
+
+    std::vector<unsigned> order;
+    if (reorder and nrows == ncols) {
+        order = csr_minimum_degree_ordering(A);
+    } else {
+        order.resize(ncols);
+        std::iota(order.begin(), order.end(), 0);
+    }
+
+    // Active rows, and the active rows that have an entry in each column
+    std::vector<std::map<unsigned, RCP<const Basic>>> rows(nrows);
+    std::vector<std::set<unsigned>> cols(ncols);
+    for (unsigned i = 0; i < nrows; i++) {
+        for (unsigned jj = A.p_[i]; jj < A.p_[i + 1]; jj++) {
+            RCP<const Basic> e = csr_normalize(A.x_[jj]);
+            if (not is_true(is_zero(*e))) {
+                rows[i].insert({A.j_[jj], e});
+                cols[A.j_[jj]].insert(i);
+            }
+        }
+    }
+
+    // Multipliers of each row, by elimination step
+    std::vector<std::vector<std::pair<unsigned, RCP<const Basic>>>> lrows(
+        nrows);
+    std::vector<std::map<unsigned, RCP<const Basic>>> urows;
+    std::vector<bool> pivoted(nrows, false);
+    std::vector<unsigned> skipped;
+    p.clear();
+    q.clear();
+
+    for (unsigned c : order) {
+        if (p.size() == nrows) {
+            skipped.push_back(c);
+            continue;
+        }
+        // Prefer the diagonal entry, then the shortest row
+        unsigned r = nrows;
+        if (c < nrows and cols[c].count(c)) {
+            r = c;
+        } else {
+            for (unsigned i : cols[c]) {
+                if (r == nrows or rows[i].size() < rows[r].size()) {
+                    r = i;
+                }
+            }
+        }
+        if (r == nrows) {
+            // Every active row is zero in this column
+            skipped.push_back(c);
+            continue;
+        }
+
+        const unsigned k = static_cast<unsigned>(p.size());
+        const RCP<const Basic> pivot = rows[r][c];
+        for (const auto &e : rows[r]) {
+            cols[e.first].erase(r);
+        }
+        std::vector<unsigned> targets(cols[c].begin(), cols[c].end());
+        for (unsigned i : targets) {
+            RCP<const Basic> factor = csr_normalize(div(rows[i][c], pivot));
+            lrows[i].push_back({k, factor});
+            rows[i].erase(c);
+            cols[c].erase(i);
+            for (const auto &e : rows[r]) {
+                if (e.first == c) {
+                    continue;
+                }
+                RCP<const Basic> t = SymEngine::mul(factor, e.second);
+                auto it = rows[i].find(e.first);
+                if (it == rows[i].end()) {
+                    rows[i].insert(
+                        {e.first, csr_normalize(SymEngine::mul(minus_one, t))});
+                    cols[e.first].insert(i);
+                } else {
+                    it->second = csr_normalize(sub(it->second, t));
+                    if (is_true(is_zero(*it->second))) {
+                        rows[i].erase(it);
+                        cols[e.first].erase(i);
+                    }
+                }
+            }
+        }
+        p.push_back(r);
+        q.push_back(c);
+        pivoted[r] = true;
+        urows.push_back(std::move(rows[r]));
+        rows[r].clear();
+    }
+
+    const unsigned rank = static_cast<unsigned>(p.size());
+    for (unsigned i = 0; i < nrows; i++) {
+        if (not pivoted[i]) {
+            p.push_back(i);
+        }
+    }
+    q.insert(q.end(), skipped.begin(), skipped.end());
+
+    std::vector<unsigned> qinv(ncols);
+    for (unsigned i = 0; i < ncols; i++) {
+        qinv[q[i]] = i;
+    }
+
+    std::vector<unsigned> lp(1, 0), lj, up(1, 0), uj;
+    vec_basic lx, ux;
+    for (unsigned i = 0; i < nrows; i++) {
+        for (const auto &e : lrows[p[i]]) {
+            lj.push_back(e.first);
+            lx.push_back(e.second);
+        }
+        lj.push_back(i);
+        lx.push_back(one);
+        lp.push_back(static_cast<unsigned>(lj.size()));
+
+        if (i < rank) {
+            std::vector<std::pair<unsigned, RCP<const Basic>>> entries;
+            for (const auto &e : urows[i]) {
+                entries.push_back({qinv[e.first], e.second});
+            }
+            std::sort(entries.begin(), entries.end(),
+                      [](const std::pair<unsigned, RCP<const Basic>> &a,
+                         const std::pair<unsigned, RCP<const Basic>> &b) {
+                          return a.first < b.first;
+                      });
+            for (const auto &e : entries) {
+                uj.push_back(e.first);
+                ux.push_back(e.second);
+            }
+        }
+        up.push_back(static_cast<unsigned>(uj.size()));
+    }
+    L = CSRMatrix(nrows, nrows, std::move(lp), std::move(lj), std::move(lx));
+    U = CSRMatrix(nrows, ncols, std::move(up), std::move(uj), std::move(ux));
+    return rank;
+}
+
 } // namespace SymEngine
@@ -30,14 +30,23 @@ protected:
     const map_basic_basic &subs_dict_;
     map_basic_basic visited;
     bool cache;
+    // Symbol signature bits of the keys if they are all Symbols, otherwise 0
+    hash_t keys_signature_;
 
 public:
     XReplaceVisitor(const map_basic_basic &subs_dict, bool cache = true)
-        : subs_dict_(subs_dict), cache(cache)
+        : subs_dict_(subs_dict), cache(cache), keys_signature_(0)
     {
         if (cache) {
             visited = subs_dict;
         }
+        for (const auto &p : subs_dict) {
+            if (not is_a_sub<Symbol>(*p.first)) {
+                keys_signature_ = 0;
+                break;
+            }
+            keys_signature_ |= symbol_signature_bit(*p.first);
+        }
     }
     // TODO : Polynomials, Series, Sets
     void bvisit(const Basic &x)
@@ -323,6 +332,12 @@ public:
 
     RCP<const Basic> apply(const RCP<const Basic> &x)
     {
+        if (keys_signature_ != 0
+            and (x->symbol_signature() & keys_signature_) == 0) {
+            // None of the symbols to replace occur in `x`
+            result_ = x;
+            return result_;
+        }
         if (cache) {
             auto it = visited.find(x);
             if (it != visited.end()) {
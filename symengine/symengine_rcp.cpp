@@ -1,4 +1,8 @@
 #include <symengine/symengine_rcp.h>
+#include <new>
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+#include <mutex>
+#endif
 
 #ifdef WITH_SYMENGINE_TEUCHOS
 #include <symengine/utilities/teuchos/Teuchos_RCP.hpp>
@@ -7,6 +11,154 @@
 namespace SymEngine
 {
 
+#ifdef WITH_SYMENGINE_POOL_ALLOCATOR
+
+namespace
+{
+
+const std::size_t pool_granularity = 16;
+const std::size_t pool_size_classes = 16;
+const std::size_t pool_max_size = pool_granularity * pool_size_classes;
+const std::size_t pool_chunk_size = 64 * 1024;
+
+struct PoolBlock {
+    PoolBlock *next;
+};
+
+struct Pool {
+    PoolBlock *free_list[pool_size_classes];
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+    bool registered;
+#endif
+};
+
+// Pool is trivially destructible, so objects released during static
+// destruction (e.g. the global constants) still find valid free lists.
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+thread_local Pool pool = {};
+#else
+Pool pool = {};
+#endif
+
+inline std::size_t pool_size_class(std::size_t size)
+{
+    return (size - 1) / pool_granularity;
+}
+
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+// Blocks can be freed by another thread than the one that allocated them and
+// can outlive the thread owning the free list, so chunks are never given back
+// to the system. Instead the free lists of a thread are moved to a shared
+// depot when it exits, and threads refill from the depot before carving new
+// chunks. This keeps memory bounded by the peak number of live blocks even
+// when short-lived threads free blocks allocated elsewhere.
+struct PoolDepot {
+    std::mutex mutex;
+    PoolBlock *free_list[pool_size_classes] = {};
+};
+
+// Never destroyed, as threads may still exit during static destruction
+PoolDepot &pool_depot()
+{
+    static PoolDepot *depot = new PoolDepot();
+    return *depot;
+}
+
+struct PoolReleaser {
+    ~PoolReleaser()
+    {
+        PoolDepot &depot = pool_depot();
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        for (std::size_t c = 0; c < pool_size_classes; c++) {
+            PoolBlock *head = pool.free_list[c];
+            if (head == nullptr)
+                continue;
+            PoolBlock *tail = head;
+            while (tail->next != nullptr)
+                tail = tail->next;
+            tail->next = depot.free_list[c];
+            depot.free_list[c] = head;
+            pool.free_list[c] = nullptr;
+        }
+    }
+};
+
+// Makes sure the free lists of this thread are released when it exits
+void pool_register_thread()
+{
+    static thread_local PoolReleaser releaser;
+    (void)releaser;
+    pool.registered = true;
+}
+#endif
+
+// Carves a new chunk into blocks of size class `c`, unless another thread left
+// free blocks of that size in the depot
+PoolBlock *pool_refill(std::size_t c)
+{
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+    if (not pool.registered)
+        pool_register_thread();
+    {
+        PoolDepot &depot = pool_depot();
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        PoolBlock *head = depot.free_list[c];
+        if (head != nullptr) {
+            depot.free_list[c] = nullptr;
+            return head;
+        }
+    }
+#endif
+    const std::size_t block_size = (c + 1) * pool_granularity;
+    const std::size_t n = pool_chunk_size / block_size;
+    char *chunk = static_cast<char *>(::operator new(n * block_size));
+    PoolBlock *head = nullptr;
+    for (std::size_t i = n; i-- > 0;) {
+        PoolBlock *b = reinterpret_cast<PoolBlock *>(chunk + i * block_size);
+        b->next = head;
+        head = b;
+    }
+    return head;
+}
+
+} // namespace
+
+void *pool_allocate(std::size_t size)
+{
+    if (size == 0)
+        size = 1;
+    if (size > pool_max_size)
+        return ::operator new(size);
+    const std::size_t c = pool_size_class(size);
+    PoolBlock *b = pool.free_list[c];
+    if (b == nullptr)
+        b = pool_refill(c);
+    pool.free_list[c] = b->next;
+    return b;
+}
+
+void pool_deallocate(void *p, std::size_t size) SYMENGINE_NOEXCEPT
+{
+    if (p == nullptr)
+        return;
+    if (size == 0)
+        size = 1;
+    if (size > pool_max_size) {
+        ::operator delete(p);
+        return;
+    }
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+    if (not pool.registered)
+        pool_register_thread();
+#endif
+    const std::size_t c = pool_size_class(size);
+    PoolBlock *b = static_cast<PoolBlock *>(p);
+    b->next = pool.free_list[c];
+    pool.free_list[c] = b;
+}
+
+#endif // WITH_SYMENGINE_POOL_ALLOCATOR
+
 #ifdef WITH_SYMENGINE_RCP
 
 void print_stack_on_segfault()
@@ -27,6 +27,55 @@
 namespace SymEngine
 {
 
+#if defined(WITH_SYMENGINE_POOL_ALLOCATOR)
+
+/* Pool allocator */
+
+// Small objects are served from free lists kept per 16 byte size class (one
+// set of free lists per thread if WITH_SYMENGINE_THREAD_SAFE is enabled),
+// larger requests are forwarded to the global operator new.
+
+//! Allocates `size` bytes from the pools
+void *pool_allocate(std::size_t size);
+//! Returns `p`, obtained from `pool_allocate(size)`, to the pools
+void pool_deallocate(void *p, std::size_t size) SYMENGINE_NOEXCEPT;
+
+//! Standard allocator drawing from the same pools as `make_rcp()`
+template <class T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+
+    PoolAllocator() SYMENGINE_NOEXCEPT {}
+    template <class U>
+    PoolAllocator(const PoolAllocator<U> &) SYMENGINE_NOEXCEPT
+    {
+    }
+    T *allocate(std::size_t n)
+    {
+        return static_cast<T *>(pool_allocate(n * sizeof(T)));
+    }
+    void deallocate(T *p, std::size_t n) SYMENGINE_NOEXCEPT
+    {
+        pool_deallocate(p, n * sizeof(T));
+    }
+};
+
+template <class T, class U>
+inline bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &)
+{
+    return true;
+}
+
+template <class T, class U>
+inline bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &)
+{
+    return false;
+}
+
+#endif // WITH_SYMENGINE_POOL_ALLOCATOR
+
 #if defined(WITH_SYMENGINE_RCP)
 
 /* Ptr */
@@ -318,6 +367,20 @@ public:
 #endif
     }
 
+#if defined(WITH_SYMENGINE_POOL_ALLOCATOR)
+    // Objects created by make_rcp() are allocated from the pools. The
+    // destructor of Basic is virtual, so `size` is the size of the most
+    // derived class.
+    static void *operator new(std::size_t size)
+    {
+        return pool_allocate(size);
+    }
+    static void operator delete(void *p, std::size_t size) SYMENGINE_NOEXCEPT
+    {
+        pool_deallocate(p, size);
+    }
+#endif
+
     // Everything below is private interface
 private:
 #if defined(WITH_SYMENGINE_RCP)
@@ -3,6 +3,7 @@
 
 #include <symengine/add.h>
 #include <symengine/pow.h>
+#include <symengine/rings.h>
 #include <symengine/complex_double.h>
 #include <symengine/real_mpfr.h>
 #include <symengine/symengine_exception.h>
@@ -23,6 +24,7 @@ using SymEngine::I;
 using SymEngine::Inf;
 using SymEngine::Integer;
 using SymEngine::integer;
+using SymEngine::integer_class;
 using SymEngine::is_a;
 using SymEngine::Log;
 using SymEngine::make_rcp;
@@ -35,6 +37,8 @@ using SymEngine::Nan;
 using SymEngine::NegInf;
 using SymEngine::Number;
 using SymEngine::one;
+using SymEngine::outArg;
+using SymEngine::packed_expand;
 using SymEngine::pi;
 using SymEngine::Pow;
 using SymEngine::pow;
@@ -1483,3 +1487,113 @@ TEST_CASE("Expand3: arit", "[arit]")
                      .count()
               << "ms" << std::endl;
 }
+
+TEST_CASE("Expand4: arit", "[arit]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> z = symbol("z");
+    RCP<const Basic> w = symbol("w");
+
+    RCP<const Basic> e, r1, r2;
+
+    e = pow(add(add(add(x, y), z), w), integer(20));
+    r1 = expand(e);
+    r2 = expand(e, true, 4);
+    REQUIRE(eq(*r1, *r2));
+    REQUIRE(rcp_dynamic_cast<const Add>(r2)->get_dict().size() == 1771);
+
+    e = mul(pow(add(add(mul(integer(2), x), pow(y, integer(2))), integer(3)),
+                integer(7)),
+            add(e, w));
+    r1 = expand(e);
+    r2 = expand(e, true, 3);
+    REQUIRE(eq(*r1, *r2));
+
+    e = pow(add(add(x, sin(y)), integer(1)), integer(15));
+    r1 = expand(e, false);
+    r2 = expand(e, false, 2);
+    REQUIRE(eq(*r1, *r2));
+
+    // Deep expansions of polynomials with integer coefficients are done by
+    // packed_expand, so use inputs it rejects to reach the parallel path
+    e = pow(add(add(x, div(y, integer(2))), z), integer(12));
+    r1 = expand(e);
+    r2 = expand(e, true, 3);
+    REQUIRE(eq(*r1, *r2));
+    REQUIRE(rcp_dynamic_cast<const Add>(r2)->get_dict().size() == 91);
+
+    e = pow(add(add(sin(x), y), integer(2)), integer(10));
+    r1 = expand(e);
+    r2 = expand(e, true, 2);
+    REQUIRE(eq(*r1, *r2));
+    REQUIRE(rcp_dynamic_cast<const Add>(r2)->get_dict().size() == 65);
+}
+
+TEST_CASE("Expand5: arit", "[arit]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> z = symbol("z");
+    RCP<const Basic> w = symbol("w");
+    RCP<const Basic> e, r;
+
+    // Only polynomials with integer coefficients that need expanding
+    REQUIRE(not packed_expand(add(x, y), outArg(r)));
+    REQUIRE(not packed_expand(pow(add(x, sqrt(y)), integer(2)), outArg(r)));
+    REQUIRE(not packed_expand(pow(add(x, div(y, integer(2))), integer(2)),
+                              outArg(r)));
+    REQUIRE(not packed_expand(pow(add(x, y), integer(-2)), outArg(r)));
+
+    REQUIRE(packed_expand(pow(add(x, y), integer(2)), outArg(r)));
+    e = add(add(pow(x, integer(2)), mul(integer(2), mul(x, y))),
+            pow(y, integer(2)));
+    REQUIRE(eq(*r, *e));
+
+    REQUIRE(packed_expand(mul(add(x, y), sub(x, y)), outArg(r)));
+    e = sub(pow(x, integer(2)), pow(y, integer(2)));
+    REQUIRE(eq(*r, *e));
+
+    REQUIRE(packed_expand(
+        mul(mul(x, add(x, integer(1))), sub(x, integer(1))), outArg(r)));
+    REQUIRE(eq(*r, *sub(pow(x, integer(3)), x)));
+
+    // Terms cancelling to zero
+    e = add(add(pow(x, integer(2)), mul(integer(2), mul(x, y))),
+            pow(y, integer(2)));
+    REQUIRE(packed_expand(sub(pow(add(x, y), integer(2)), e), outArg(r)));
+    REQUIRE(eq(*r, *zero));
+
+    // Coefficients overflowing a machine word
+    e = pow(add(x, integer(1099511627776)), integer(3));
+    REQUIRE(packed_expand(e, outArg(r)));
+    integer_class c(1099511627776);
+    e = add(add(add(pow(x, integer(3)),
+                    mul(integer(3 * c), pow(x, integer(2)))),
+                mul(integer(3 * c * c), x)),
+            integer(c * c * c));
+    REQUIRE(eq(*r, *e));
+
+    e = pow(add(add(add(x, y), z), w), integer(20));
+    REQUIRE(packed_expand(e, outArg(r), 4));
+    // A shallow expansion does not go through packed_expand
+    REQUIRE(eq(*r, *expand(e, false)));
+    REQUIRE(rcp_dynamic_cast<const Add>(r)->get_dict().size() == 1771);
+    // Sum of the coefficients is 4**20
+    r = r->subs({{x, one}, {y, one}, {z, one}, {w, one}});
+    REQUIRE(eq(*r, *integer(1099511627776)));
+
+    // Large powers of single terms
+    e = mul(pow(x, integer(100000000)), pow(add(x, integer(1)), integer(2)));
+    REQUIRE(packed_expand(e, outArg(r)));
+    e = add(add(pow(x, integer(100000002)),
+                mul(integer(2), pow(x, integer(100000001)))),
+            pow(x, integer(100000000)));
+    REQUIRE(eq(*r, *e));
+
+    // Nested powers
+    e = pow(add(pow(add(x, mul(integer(2), y)), integer(3)), z), integer(4));
+    REQUIRE(packed_expand(e, outArg(r)));
+    r = r->subs({{x, integer(3)}, {y, integer(-5)}, {z, integer(7)}});
+    REQUIRE(eq(*r, *integer(12745506816)));
+}
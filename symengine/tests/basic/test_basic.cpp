@@ -18,6 +18,7 @@ using SymEngine::down_cast;
 using SymEngine::EulerGamma;
 using SymEngine::free_symbols;
 using SymEngine::function_symbol;
+using SymEngine::gradient;
 using SymEngine::FunctionSymbol;
 using SymEngine::has_symbol;
 using SymEngine::I;
@@ -47,10 +48,12 @@ using SymEngine::sdiff;
 using SymEngine::set_basic;
 using SymEngine::Symbol;
 using SymEngine::symbol;
+using SymEngine::symbol_signature_bit;
 using SymEngine::umap_basic_basic;
 using SymEngine::umap_basic_num;
 using SymEngine::unified_compare;
 using SymEngine::vec_basic;
+using SymEngine::vec_sym;
 using SymEngine::zero;
 
 using namespace SymEngine::literals;
@@ -594,6 +597,36 @@ TEST_CASE("Diff: Basic", "[basic]")
     REQUIRE(eq(*r1, *r2));
 }
 
+TEST_CASE("Gradient: Basic", "[basic]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Symbol> z = symbol("z");
+    RCP<const Basic> i2 = integer(2);
+    RCP<const Basic> e, f;
+    vec_basic g;
+
+    e = add(mul(x, y), sin(mul(x, y)));
+    e = add(pow(e, i2), mul(pow(x, y), log(add(e, z))));
+    e = add(e, mul(x, function_symbol("f", {x, y})));
+    vec_sym xs = {x, y, z, x, symbol("t")};
+    g = gradient(e, xs);
+    REQUIRE(g.size() == 5);
+    for (unsigned i = 0; i < 4; i++) {
+        REQUIRE(eq(*expand(sub(g[i], e->diff(xs[i]))), *zero));
+    }
+    REQUIRE(eq(*g[0], *g[3]));
+    REQUIRE(eq(*g[4], *zero));
+
+    g = gradient(integer(5), {x});
+    REQUIRE(eq(*g[0], *zero));
+
+    f = cos(pow(x, i2));
+    g = gradient(f, {x, y});
+    REQUIRE(eq(*g[0], *f->diff(x)));
+    REQUIRE(eq(*g[1], *zero));
+}
+
 TEST_CASE("compare: Basic", "[basic]")
 {
     RCP<const Basic> r1, r2;
@@ -1127,3 +1160,68 @@ TEST_CASE("args: Basic", "[basic]")
     r1 = log(pi);
     REQUIRE(vec_basic_eq_perm(r1->get_args(), {pi}));
 }
+
+TEST_CASE("intern: Basic", "[basic]")
+{
+    RCP<const Basic> r1, r2;
+    RCP<const Symbol> x, y;
+
+    REQUIRE(not SymEngine::is_interning());
+    x = symbol("x");
+    REQUIRE(x.get() != symbol("x").get());
+
+    SymEngine::set_interning(true);
+    REQUIRE(SymEngine::is_interning());
+    x = symbol("x");
+    y = symbol("y");
+    REQUIRE(x.get() == symbol("x").get());
+    REQUIRE(x.get() != y.get());
+
+    r1 = add(mul(integer(2), x), pow(y, integer(3)));
+    r2 = add(pow(symbol("y"), integer(3)), mul(x, integer(2)));
+    REQUIRE(r1.get() == r2.get());
+    REQUIRE(mul(x, y).get() == mul(y, x).get());
+    REQUIRE(pow(x, y).get() == pow(symbol("x"), symbol("y")).get());
+
+    SymEngine::set_interning(false);
+    REQUIRE(add(x, y).get() != add(x, y).get());
+    REQUIRE(eq(*add(x, y), *add(x, y)));
+
+    size_t n = SymEngine::intern_table_size();
+    REQUIRE(n > 0);
+    r1 = r2 = SymEngine::null;
+    SymEngine::intern_collect();
+    REQUIRE(SymEngine::intern_table_size() < n);
+    SymEngine::intern_collect();
+    REQUIRE(SymEngine::intern_table_size() == 2);
+
+    SymEngine::intern_clear();
+    REQUIRE(SymEngine::intern_table_size() == 0);
+}
+
+TEST_CASE("symbol_signature: Basic", "[basic]")
+{
+    RCP<const Basic> r1, r2;
+    RCP<const Symbol> x, y, z;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    r1 = add(mul(integer(2), x), sin(pow(y, integer(3))));
+    REQUIRE((r1->symbol_signature() & symbol_signature_bit(*x)) != 0);
+    REQUIRE((r1->symbol_signature() & symbol_signature_bit(*y)) != 0);
+    REQUIRE(r1->symbol_signature()
+            == (x->symbol_signature() | y->symbol_signature()));
+
+    r2 = add(integer(2), sin(pi));
+    REQUIRE(r2->symbol_signature() == SymEngine::symbol_free_signature);
+    REQUIRE(eq(*r2->diff(x), *zero));
+    REQUIRE(free_symbols(*r2).empty());
+    REQUIRE(not has_symbol(*r2, *x));
+
+    r1 = add(r1, r2);
+    REQUIRE(eq(*r1->subs({{z, integer(5)}}), *r1));
+    REQUIRE(eq(*r1->xreplace({{x, z}}),
+               *add(add(mul(integer(2), z), sin(pow(y, integer(3)))), r2)));
+    REQUIRE(not has_symbol(*r1, *z));
+}
@@ -1073,3 +1073,83 @@ TEST_CASE("GaloisFieldDict eval : Basic", "[basic]")
     std::vector<integer_class> resa = {1_z, 6_z, 6_z, 1_z};
     REQUIRE(d1.gf_multi_eval({0_z, 1_z, 2_z, 3_z}) == resa);
 }
+
+TEST_CASE("GaloisFieldDict long multiplication and division : Basic",
+          "[basic]")
+{
+    // Sizes around the Karatsuba, NTT and Newton division thresholds, checked
+    // against the schoolbook product
+    std::vector<integer_class> moduli = {2_z, 7_z, 998244353_z, 2147483647_z};
+    std::vector<unsigned> sizes = {1, 20, 40, 70, 130, 300, 700};
+    unsigned long seed = 12345;
+    auto random_poly = [&seed](unsigned n, const integer_class &p) {
+        std::vector<integer_class> v(n);
+        for (auto &c : v) {
+            seed = (seed * 6364136223846793005ULL + 1442695040888963407ULL)
+                   & 0xFFFFFFFFFFFFULL;
+            c = integer_class(seed >> 8) % p;
+        }
+        if (n > 0)
+            v.back() = 1;
+        return GaloisFieldDict::from_vec(v, p);
+    };
+    for (const auto &p : moduli) {
+        for (unsigned na : sizes) {
+            for (unsigned nb : sizes) {
+                GaloisFieldDict a = random_poly(na, p);
+                GaloisFieldDict b = random_poly(nb, p);
+                GaloisFieldDict c = a * b;
+
+                std::vector<integer_class> expected(na + nb - 1, 0_z);
+                for (unsigned i = 0; i < na; i++)
+                    for (unsigned j = 0; j < nb; j++)
+                        expected[i + j] += a.dict_[i] * b.dict_[j];
+                REQUIRE(c == GaloisFieldDict::from_vec(expected, p));
+
+                GaloisFieldDict r = random_poly(nb - 1, p);
+                GaloisFieldDict quo, rem;
+                (c + r).gf_div(b, outArg(quo), outArg(rem));
+                REQUIRE(quo == a);
+                REQUIRE(rem == r);
+                REQUIRE((c + r) / b == a);
+                REQUIRE((c + r) % b == r);
+            }
+        }
+    }
+}
+
+TEST_CASE("GaloisFieldDict multi_eval, interpolate : Basic", "[basic]")
+{
+    integer_class p = 1000003_z;
+    std::vector<integer_class> v;
+    integer_class c = 1_z;
+    for (unsigned i = 0; i < 500; i++) {
+        c = (c * 1103515245 + 12345) % p;
+        v.push_back(c);
+    }
+    GaloisFieldDict f = GaloisFieldDict::from_vec(v, p);
+
+    // distinct points, some negative, spanning many blocks of the
+    // subproduct tree
+    std::vector<integer_class> pts;
+    for (int i = -200; i < 300; i++)
+        pts.push_back(integer_class(7 * i));
+    std::vector<integer_class> vals = f.gf_multi_eval(pts);
+    REQUIRE(vals.size() == pts.size());
+    for (unsigned i = 0; i < pts.size(); i++) {
+        integer_class e = f.gf_eval(pts[i]);
+        mp_fdiv_r(e, e, p);
+        REQUIRE(vals[i] == e);
+    }
+    REQUIRE(GaloisFieldDict::gf_interpolate(pts, vals, p) == f);
+
+    GaloisFieldDict g = GaloisFieldDict::from_vec({1_z, 2_z}, 11_z);
+    REQUIRE(GaloisFieldDict::gf_interpolate({0_z, 1_z, 5_z}, {1_z, 3_z, 0_z},
+                                            11_z)
+            == g);
+    REQUIRE(GaloisFieldDict::gf_interpolate({}, {}, 11_z)
+            == GaloisFieldDict::from_vec({}, 11_z));
+    CHECK_THROWS_AS(GaloisFieldDict::gf_interpolate({1_z, 12_z}, {1_z, 2_z},
+                                                    11_z),
+                    SymEngineException);
+}
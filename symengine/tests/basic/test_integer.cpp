@@ -2,6 +2,7 @@
 
 #include <symengine/integer.h>
 #include <symengine/symengine_exception.h>
+#include <limits>
 
 using SymEngine::Integer;
 using SymEngine::integer;
@@ -116,3 +117,26 @@ TEST_CASE("fix#461: integer", "[integer]")
     CHECK(ir->__str__() == "-12345");
     CHECK(mp_get_hex_str(val) == "-3039");
 }
+
+TEST_CASE("small integer cache: integer", "[integer]")
+{
+    RCP<const Integer> i, j;
+#if SYMENGINE_SMALL_INTEGER_CACHE > 0
+    REQUIRE(integer(5).get() == integer(5).get());
+    REQUIRE(integer(-3).get() == integer(integer_class(-3)).get());
+    REQUIRE(integer(2u).get() == integer(1)->addint(*integer(1)).get());
+#endif
+
+    const long big = std::numeric_limits<long>::max();
+    i = integer(big);
+    j = i->addint(*i);
+    REQUIRE(j->as_integer_class() == integer_class(big) + integer_class(big));
+    j = i->mulint(*i);
+    REQUIRE(j->as_integer_class() == integer_class(big) * integer_class(big));
+    j = integer(-big)->addint(*integer(-big));
+    REQUIRE(j->as_integer_class() == integer_class(-big) + integer_class(-big));
+    j = integer(1L << 20)->mulint(*integer(-(1L << 20)));
+    REQUIRE(eq(*j, *integer(-(1LL << 40))));
+    j = integer(123456789)->addint(*integer(-123456789));
+    REQUIRE(j->is_zero());
+}
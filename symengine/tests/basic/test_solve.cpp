@@ -29,6 +29,7 @@ using SymEngine::interval;
 using SymEngine::Interval;
 using SymEngine::is_a;
 using SymEngine::linear_eqns_to_matrix;
+using SymEngine::linear_eqns_to_sparse_matrix;
 using SymEngine::linsolve;
 using SymEngine::logical_and;
 using SymEngine::mul;
@@ -45,6 +46,7 @@ using SymEngine::Set;
 using SymEngine::set_union;
 using SymEngine::solve;
 using SymEngine::solve_poly_quartic;
+using SymEngine::sparse_linsolve;
 using SymEngine::symbol;
 using SymEngine::Symbol;
 using SymEngine::SymEngineException;
@@ -446,6 +448,27 @@ TEST_CASE("linsolve", "[Solve]")
     REQUIRE(eq(*solns[1], *zero));
     REQUIRE(eq(*solns[2], *zero));
 
+    solns = sparse_linsolve(
+        {add({x, mul(integer(2), y), mul(integer(3), z), mul(integer(4), t),
+              integer(16)}),
+         add({mul(integer(2), x), mul(integer(3), z), integer(11)}),
+         add({mul(integer(3), x), mul(integer(3), y), integer(6)}),
+         add({mul(integer(9), x), mul(integer(6), t), integer(15)})},
+        {x, y, z, t});
+    REQUIRE(solns.size() == 4);
+    REQUIRE(eq(*solns[0], *integer(-1)));
+    REQUIRE(eq(*solns[1], *integer(-1)));
+    REQUIRE(eq(*solns[2], *integer(-3)));
+    REQUIRE(eq(*solns[3], *integer(-1)));
+
+    auto sys = linear_eqns_to_sparse_matrix(
+        {sub(y, integer(3)), sub(x, integer(2))}, {x, y});
+    REQUIRE(sys.first == DenseMatrix(2, 2, {integer(0), integer(1), integer(1),
+                                            integer(0)}));
+    solns = linsolve(sys.first, sys.second);
+    REQUIRE(eq(*solns[0], *integer(2)));
+    REQUIRE(eq(*solns[1], *integer(3)));
+
     solns = linsolve({sub(x, integer(2)), sub(y, integer(3))}, {x, y});
 
     REQUIRE(solns.size() == 2);
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <array>
 
+#include <symengine/bytecode_double.h>
 #include <symengine/lambda_double.h>
 #include <symengine/symengine_exception.h>
 #include <symengine/eval.h>
@@ -12,8 +13,13 @@
 #ifdef HAVE_SYMENGINE_LLVM
 #include <symengine/llvm_double.h>
 #include <symengine/eval_mpfr.h>
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+using SymEngine::get_llvm_cache_directory;
 using SymEngine::LLVMDoubleVisitor;
 using SymEngine::LLVMFloatVisitor;
+using SymEngine::set_llvm_cache_directory;
 
 #ifdef HAVE_SYMENGINE_MPFR
 using SymEngine::RealMPFR;
@@ -36,6 +42,8 @@ using SymEngine::atan2;
 using SymEngine::atanh;
 using SymEngine::Basic;
 using SymEngine::boolTrue;
+using SymEngine::BytecodeComplexDoubleVisitor;
+using SymEngine::BytecodeRealDoubleVisitor;
 using SymEngine::Catalan;
 using SymEngine::ceiling;
 using SymEngine::complex_double;
@@ -45,6 +53,7 @@ using SymEngine::cot;
 using SymEngine::coth;
 using SymEngine::csc;
 using SymEngine::csch;
+using SymEngine::div;
 using SymEngine::down_cast;
 using SymEngine::E;
 using SymEngine::Eq;
@@ -218,6 +227,59 @@ TEST_CASE("Evaluate to std::complex<double>", "[lambda_complex_double]")
     CHECK_THROWS_AS(v.init({x}, *r), SymEngineException);
 }
 
+TEST_CASE("Evaluate batch", "[lambda_double]")
+{
+    RCP<const Basic> x, y, z, r, s, t;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    r = add(mul(integer(3), pow(x, integer(2))),
+            mul(sin(add(x, y)), pow(y, z)));
+    s = add(log(add(pow(x, integer(2)), integer(1))),
+            div(pow(E, mul(y, z)), add(x, integer(4))));
+    // gamma and max are evaluated point by point
+    t = add(max({x, y, z}), mul(gamma(z), pow(sin(add(x, y)), integer(2))));
+
+    // More points than a block, with padding after each input
+    const size_t n = 150, stride = 160;
+    std::vector<double> inps(3 * stride), outs(3 * stride);
+    for (size_t k = 0; k < n; k++) {
+        inps[k] = 0.01 * k - 0.5;
+        inps[stride + k] = 1.0 + 0.02 * k;
+        inps[2 * stride + k] = 0.5 + 0.001 * k;
+    }
+    for (bool cse : {false, true}) {
+        LambdaRealDoubleVisitor v;
+        v.init({x, y, z}, {r, s, t}, cse);
+        v.call_batch(outs.data(), inps.data(), n, stride);
+        double d[3];
+        for (size_t k = 0; k < n; k++) {
+            double p[] = {inps[k], inps[stride + k], inps[2 * stride + k]};
+            v.call(d, p);
+            for (size_t i = 0; i < 3; i++) {
+                REQUIRE(::fabs(outs[i * stride + k] - d[i]) < 1e-12);
+            }
+        }
+    }
+
+    LambdaComplexDoubleVisitor v;
+    v.init({x, y, z}, {r, s}, true);
+    std::vector<std::complex<double>> cinps(3 * n), couts(2 * n);
+    for (size_t k = 0; k < 3 * n; k++) {
+        cinps[k] = std::complex<double>(0.01 * k, 1.0 - 0.01 * k);
+    }
+    v.call_batch(couts.data(), cinps.data(), n, n);
+    std::complex<double> d[2];
+    for (size_t k = 0; k < n; k++) {
+        std::complex<double> p[] = {cinps[k], cinps[n + k], cinps[2 * n + k]};
+        v.call(d, p);
+        for (size_t i = 0; i < 2; i++) {
+            REQUIRE(std::abs(couts[i * n + k] - d[i]) < 1e-12);
+        }
+    }
+}
+
 TEST_CASE("Evaluate functions", "[lambda_gamma]")
 {
     RCP<const Basic> x, y, z, r;
@@ -225,6 +287,7 @@ TEST_CASE("Evaluate functions", "[lambda_gamma]")
     x = symbol("x");
 
     LambdaRealDoubleVisitor v;
+    BytecodeRealDoubleVisitor v2;
 
     std::vector<std::tuple<RCP<const Basic>, double, double>> testvec = {
         std::make_tuple(pow(E, cos(x)), 1.3, 1.30669209920819),
@@ -276,6 +339,9 @@ TEST_CASE("Evaluate functions", "[lambda_gamma]")
             v.init({x}, *expr);
             d = v.call({arg});
             REQUIRE(::fabs(d - ref) < 1e-12);
+            v2.init({x}, *expr);
+            d = v2.call({arg});
+            REQUIRE(::fabs(d - ref) < 1e-12);
         }
     }
     v.init({}, *Nan);
@@ -286,6 +352,88 @@ TEST_CASE("Evaluate functions", "[lambda_gamma]")
     REQUIRE(std::isinf(v.call({})));
 }
 
+TEST_CASE("Check bytecode and lambda are equal", "[bytecode_double]")
+{
+    RCP<const Basic> x, y, z, r, a, b;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    a = add(x, z);
+    b = add(y, z);
+
+    vec_basic exprs = {
+        log(a),   abs(a),      tan(a),      sinh(a),     cosh(a),    tanh(a),
+        asinh(b), acosh(b),    atanh(a),    asin(a),     acos(a),    atan(a),
+        gamma(a), loggamma(a), erf(a),      erfc(a),     floor(a),   ceiling(a),
+        sign(a),  max({a, b}), min({a, b}), atan2(a, b), truncate(a)};
+
+    for (unsigned i = 0; i < exprs.size(); i++) {
+        exprs[i] = add(exprs[i], z);
+    }
+
+    r = add(sin(x), add(mul(pow(y, integer(4)), mul(z, integer(2))),
+                        pow(sin(x), integer(2))));
+    exprs.push_back(r);
+    exprs.push_back(neg(abs(z)));
+    exprs.push_back(add(pow(E, mul(x, y)), pow(b, a)));
+
+    // Piecewise, with subexpressions shared between the branches and after
+    auto int1 = interval(NegInf, integer(2), true, false);
+    auto int2 = interval(integer(2), integer(5), true, false);
+
+    SymEngine::set_boolean s = {Lt(x, integer(6)), Gt(x, integer(5))};
+    r = add(z, piecewise({{x, contains(x, int1)},
+                          {mul(a, b), contains(x, int2)},
+                          {z, Ge(x, integer(7))},
+                          {a, logical_and(s)},
+                          {add(mul(a, b), y), boolTrue}}));
+    exprs.push_back(add(r, mul(a, b)));
+
+    std::vector<std::vector<double>> points
+        = {{1.4, 3.0, -1.0}, {3.0, 2.0, 0.5}, {5.5, 1.0, 0.25},
+           {7.5, 2.5, 0.5},  {6.5, 1.5, 0.5}};
+    std::vector<double> d(exprs.size()), d2(exprs.size());
+    for (bool cse : {false, true}) {
+        LambdaRealDoubleVisitor v;
+        v.init({x, y, z}, exprs, cse);
+        BytecodeRealDoubleVisitor v2;
+        v2.init({x, y, z}, exprs, cse);
+        for (auto &p : points) {
+            v.call(d.data(), p.data());
+            v2.call(d2.data(), p.data());
+            for (unsigned i = 0; i < exprs.size(); i++) {
+                REQUIRE(((std::isnan(d[i]) and std::isnan(d2[i]))
+                         or ::fabs(d[i] - d2[i]) < 1e-12));
+            }
+        }
+    }
+
+    // Undefined symbols raise an exception
+    BytecodeRealDoubleVisitor v;
+    CHECK_THROWS_AS(v.init({x}, *add(y, x)), SymEngineException);
+    v.init({}, {Nan, Inf});
+    v.call(d.data(), nullptr);
+    REQUIRE(std::isnan(d[0]));
+    REQUIRE(std::isinf(d[1]));
+
+    r = add(x,
+            add(mul(y, z), pow(x, complex_double(std::complex<double>(3, 4)))));
+    BytecodeComplexDoubleVisitor v3;
+    v3.init({x, y, z}, {r, sin(r), mul(r, r)}, true);
+    LambdaComplexDoubleVisitor v4;
+    v4.init({x, y, z}, {r, sin(r), mul(r, r)}, true);
+    std::complex<double> inps[] = {std::complex<double>(1.5, 1.0),
+                                   std::complex<double>(2.5, 4.0),
+                                   std::complex<double>(-8.3, 3.2)};
+    std::complex<double> c[3], c2[3];
+    v3.call(c, inps);
+    v4.call(c2, inps);
+    for (unsigned i = 0; i < 3; i++) {
+        REQUIRE(std::abs(c[i] - c2[i]) < 1e-9 * std::abs(c2[i]));
+    }
+}
+
 #ifdef HAVE_SYMENGINE_LLVM
 TEST_CASE("Check llvm and lambda are equal", "[llvm_double]")
 {
@@ -561,4 +709,207 @@ TEST_CASE("Check that our default LLVM passes give correct results",
     v4.init({x, y, z}, *r);
     REQUIRE(std::isinf(v4.call({0.4f, 2.0f, 3.0f})));
 }
+
+TEST_CASE("Check llvm call_batch", "[llvm_double]")
+{
+    RCP<const Basic> x, y, z, r, s, t;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    r = add(mul(integer(3), pow(x, integer(2))),
+            mul(sin(add(x, y)), pow(y, z)));
+    s = add(log(add(pow(x, integer(2)), integer(1))),
+            div(pow(E, mul(y, z)), add(x, integer(4))));
+    t = add(tan(x),
+            piecewise({{cos(y), Lt(x, integer(0))}, {gamma(z), boolTrue}}));
+
+    // Not a multiple of any vector width
+    const size_t n = 37;
+    std::vector<double> inps(3 * n), outs(3 * n);
+    std::vector<float> finps(3 * n), fouts(3 * n);
+    for (size_t k = 0; k < n; k++) {
+        inps[k] = 0.01 * k - 0.2;
+        inps[n + k] = 1.0 + 0.02 * k;
+        inps[2 * n + k] = 0.5 + 0.001 * k;
+    }
+    for (size_t k = 0; k < 3 * n; k++) {
+        finps[k] = static_cast<float>(inps[k]);
+    }
+    for (bool symbolic_cse : {false, true}) {
+        for (unsigned opt_level : {0, 3}) {
+            LLVMDoubleVisitor v;
+            v.init({x, y, z}, {r, s, t}, symbolic_cse, opt_level, true);
+            v.call_batch(outs.data(), inps.data(), n);
+            LLVMFloatVisitor v2;
+            v2.init({x, y, z}, {r, s, t}, symbolic_cse, opt_level, true);
+            v2.call_batch(fouts.data(), finps.data(), n);
+            double d[3];
+            for (size_t k = 0; k < n; k++) {
+                double p[] = {inps[k], inps[n + k], inps[2 * n + k]};
+                v.call(d, p);
+                for (size_t i = 0; i < 3; i++) {
+                    REQUIRE(::fabs(outs[i * n + k] - d[i]) < 1e-12);
+                    REQUIRE(::fabs((fouts[i * n + k] - d[i]) / d[i]) < 1e-5);
+                }
+            }
+        }
+    }
+
+    LLVMDoubleVisitor v;
+    v.init({x, y, z}, {r, s, t}, false, 3, true);
+    // Nothing is touched without points
+    outs[0] = 42.0;
+    v.call_batch(outs.data(), inps.data(), 0);
+    REQUIRE(outs[0] == 42.0);
+
+    // libm functions are treated as pure only in the batch loop, which must
+    // still give the results of the library at domain errors
+    v.init({x}, {asin(x), atanh(x)}, false, 3, true);
+    double dinps[] = {2.0, 1.0, 0.5};
+    v.call_batch(outs.data(), dinps, 3);
+    REQUIRE(std::isnan(outs[0]));
+    REQUIRE(::fabs(outs[1] - ::asin(1.0)) < 1e-15);
+    REQUIRE(::fabs(outs[2] - ::asin(0.5)) < 1e-15);
+    REQUIRE(std::isnan(outs[3]));
+    REQUIRE(std::isinf(outs[4]));
+    REQUIRE(::fabs(outs[5] - ::atanh(0.5)) < 1e-15);
+
+    v.init({x, y, z}, {r, s, t});
+    CHECK_THROWS_AS(v.call_batch(outs.data(), inps.data(), n),
+                    SymEngineException);
+}
+
+TEST_CASE("Check llvm cache directory", "[llvm_double]")
+{
+    RCP<const Basic> x, y, r, s;
+    double d[2];
+    x = symbol("x");
+    y = symbol("y");
+    r = add(sin(x), mul(pow(y, integer(3)), cos(add(x, y))));
+    s = div(log(add(x, integer(2))), add(y, integer(1)));
+
+    // A new directory, so that nothing is loaded from an earlier run
+    llvm::SmallString<128> base, dir;
+    llvm::sys::path::system_temp_directory(true, base);
+    llvm::sys::path::append(base, "symengine_llvm_cache");
+    REQUIRE(not llvm::sys::fs::createUniqueDirectory(base, dir));
+    auto count_entries = [&dir]() {
+        std::error_code ec;
+        size_t n = 0;
+        for (llvm::sys::fs::directory_iterator it(dir, ec), end;
+             not ec and it != end; it.increment(ec)) {
+            n++;
+        }
+        REQUIRE(not ec);
+        return n;
+    };
+    REQUIRE(count_entries() == 0);
+
+    const std::string old_path = get_llvm_cache_directory();
+    set_llvm_cache_directory(dir.str().str());
+    REQUIRE(get_llvm_cache_directory() == dir.str().str());
+
+    // The first time the object code is compiled and stored
+    LLVMDoubleVisitor v;
+    v.init({x, y}, {r, s});
+    v.call(d, std::vector<double>({0.3, 1.5}).data());
+    REQUIRE(count_entries() == 1);
+    // The second time the object code is loaded from the cache
+    for (int i = 0; i < 2; i++) {
+        LLVMDoubleVisitor v2;
+        v2.init({x, y}, {r, s});
+        REQUIRE(v2.dumps() == v.dumps());
+        double d2[2];
+        v2.call(d2, std::vector<double>({0.3, 1.5}).data());
+        REQUIRE(::fabs(d[0] - d2[0]) < 1e-12);
+        REQUIRE(::fabs(d[1] - d2[1]) < 1e-12);
+    }
+
+    // Different inputs, options and types are different entries
+    LLVMDoubleVisitor v3;
+    v3.init({y, x}, {r, s});
+    v3.call(d, std::vector<double>({1.5, 0.3}).data());
+    REQUIRE(::fabs(d[0] - v.call({0.3, 1.5})) < 1e-12);
+    LLVMFloatVisitor v4;
+    v4.init({x, y}, *s);
+    REQUIRE(::fabs(v4.call({0.3f, 1.5f}) - d[1]) < 1e-6);
+
+    for (int i = 0; i < 2; i++) {
+        LLVMDoubleVisitor v5;
+        v5.init({x, y}, {r, s}, false, 3, true);
+        std::vector<double> inps = {0.3, 0.4, 1.5, 1.6}, outs(4);
+        v5.call_batch(outs.data(), inps.data(), 2);
+        v.call(d, std::vector<double>({0.4, 1.6}).data());
+        REQUIRE(::fabs(outs[1] - d[0]) < 1e-12);
+        REQUIRE(::fabs(outs[3] - d[1]) < 1e-12);
+    }
+    REQUIRE(count_entries() == 4);
+
+    set_llvm_cache_directory(old_path);
+    REQUIRE(not llvm::sys::fs::remove_directories(dir));
+}
+
+TEST_CASE("Check llvm compilation in chunks", "[llvm_double]")
+{
+    RCP<const Basic> x, y, z;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    vec_basic outputs;
+    for (int i = 0; i < 50; i++) {
+        RCP<const Basic> e = pow(add(x, integer(i)), integer(i % 5));
+        outputs.push_back(add(mul(e, sin(mul(y, integer(i)))), div(z, e)));
+    }
+    outputs.push_back(add(tan(x), piecewise({{cos(y), Lt(x, integer(0))},
+                                             {gamma(z), boolTrue}})));
+
+    LLVMDoubleVisitor v;
+    v.init({x, y, z}, outputs);
+    const size_t m = outputs.size();
+    std::vector<double> d(m), d2(m), inps = {0.3, 1.2, -0.7};
+    v.call(d.data(), inps.data());
+    for (bool symbolic_cse : {false, true}) {
+        for (unsigned nthreads : {2, 5, 100}) {
+            LLVMDoubleVisitor v2;
+            v2.init({x, y, z}, outputs, symbolic_cse, 3, true, nthreads);
+            v2.call(d2.data(), inps.data());
+            for (size_t i = 0; i < m; i++) {
+                REQUIRE(::fabs(d[i] - d2[i]) < 1e-12);
+            }
+
+            std::vector<double> binps = {0.3, -0.5, 1.2, 0.8, -0.7, 2.5},
+                                bouts(2 * m);
+            v2.call_batch(bouts.data(), binps.data(), 2);
+            for (size_t i = 0; i < m; i++) {
+                REQUIRE(::fabs(d[i] - bouts[2 * i]) < 1e-12);
+            }
+
+            // All the chunks are saved and loaded together
+            LLVMDoubleVisitor v3;
+            v3.loads(v2.dumps());
+            REQUIRE(v3.dumps() == v2.dumps());
+            v3.call(d2.data(), inps.data());
+            for (size_t i = 0; i < m; i++) {
+                REQUIRE(::fabs(d[i] - d2[i]) < 1e-12);
+            }
+            v3.call_batch(bouts.data(), binps.data(), 2);
+            for (size_t i = 0; i < m; i++) {
+                REQUIRE(::fabs(d[i] - bouts[2 * i]) < 1e-12);
+            }
+        }
+    }
+
+    LLVMFloatVisitor v4;
+    v4.init({x, y, z}, outputs, false, 2, false, 3);
+    std::vector<float> f(m), finps = {0.3f, 1.2f, -0.7f};
+    v4.call(f.data(), finps.data());
+    for (size_t i = 0; i < m; i++) {
+        REQUIRE(::fabs((f[i] - d[i]) / d[i]) < 1e-4);
+    }
+
+    CHECK_THROWS_AS(v4.loads("SymEngine LLVM chunks\n3\n1\n"),
+                    SymEngineException);
+}
 #endif
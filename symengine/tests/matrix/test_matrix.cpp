@@ -5,6 +5,7 @@
 #include <symengine/add.h>
 #include <symengine/functions.h>
 #include <symengine/complex_double.h>
+#include <symengine/eval_double.h>
 #include <symengine/pow.h>
 #include <symengine/symengine_exception.h>
 #include <symengine/visitor.h>
@@ -22,10 +23,13 @@ using SymEngine::DenseMatrix;
 using SymEngine::diag;
 using SymEngine::down_cast;
 using SymEngine::eigen_values;
+using SymEngine::eval_double;
+using SymEngine::expand;
 using SymEngine::eye;
 using SymEngine::finiteset;
 using SymEngine::function_symbol;
 using SymEngine::integer;
+using SymEngine::Integer;
 using SymEngine::is_a;
 using SymEngine::minus_one;
 using SymEngine::mul;
@@ -1886,6 +1890,134 @@ TEST_CASE("test_inverse(): matrices", "[matrices]")
     REQUIRE(C == I2);
 }
 
+TEST_CASE("test_numeric_fast_paths(): matrices", "[matrices]")
+{
+    DenseMatrix I4 = DenseMatrix(4, 4);
+    eye(I4);
+
+    DenseMatrix A = DenseMatrix(
+        4, 4, {integer(0), rational(1, 2), integer(3), integer(-1), integer(2),
+               integer(1), rational(-2, 3), integer(0), integer(5), integer(0),
+               integer(1), integer(7), integer(1), integer(1), integer(1),
+               integer(1)});
+    DenseMatrix B = DenseMatrix(4, 4);
+    DenseMatrix C = DenseMatrix(4, 4);
+
+    REQUIRE(eq(*det_bareis(A), *det_berkowitz(A)));
+
+    inverse_pivoted_LU(A, B);
+    mul_dense_dense(A, B, C);
+    REQUIRE(C == I4);
+
+    inverse_gauss_jordan(A, B);
+    mul_dense_dense(B, A, C);
+    REQUIRE(C == I4);
+
+    DenseMatrix b = DenseMatrix(4, 1, {integer(1), integer(2), integer(3),
+                                       rational(1, 5)});
+    DenseMatrix x = DenseMatrix(4, 1);
+    DenseMatrix y = DenseMatrix(4, 1);
+    pivoted_LU_solve(A, b, x);
+    mul_dense_dense(A, x, y);
+    REQUIRE(y == b);
+
+    A = DenseMatrix(
+        4, 4, {real_double(2.0), real_double(1.0), real_double(0.0),
+               real_double(0.0), real_double(1.0), real_double(3.0),
+               real_double(1.0), real_double(0.0), real_double(0.0),
+               real_double(1.0), real_double(4.0), real_double(1.0),
+               real_double(0.0), real_double(0.0), real_double(1.0),
+               real_double(5.0)});
+    RCP<const Basic> d = det_bareis(A);
+    REQUIRE(is_a<RealDouble>(*d));
+    REQUIRE(std::abs(down_cast<const RealDouble &>(*d).as_double() - 85.0)
+            < 1e-12);
+
+    DenseMatrix L = DenseMatrix(4, 4);
+    DenseMatrix U = DenseMatrix(4, 4);
+    LU(A, L, U);
+    mul_dense_dense(L, U, B);
+    for (unsigned i = 0; i < 4; i++) {
+        for (unsigned j = 0; j < 4; j++) {
+            REQUIRE(std::abs(eval_double(*sub(B.get(i, j), A.get(i, j))))
+                    < 1e-12);
+        }
+    }
+
+    // Integer matrices use fraction-free elimination, here with a row swap
+    A = DenseMatrix(
+        5, 5, {integer(0), integer(2), integer(-1), integer(3), integer(1),
+               integer(4), integer(1), integer(0), integer(-2), integer(5),
+               integer(1), integer(1), integer(1), integer(1), integer(1),
+               integer(7), integer(-3), integer(2), integer(0), integer(1),
+               integer(2), integer(0), integer(6), integer(1), integer(-4)});
+    d = det_bareis(A);
+    REQUIRE(is_a<Integer>(*d));
+    REQUIRE(eq(*d, *det_berkowitz(A)));
+
+    // More rows and columns than a block of the multiplication kernel
+    const unsigned n = 70, m = 5;
+    DenseMatrix E = DenseMatrix(n, m), F = DenseMatrix(m, n),
+                G = DenseMatrix(n, n);
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned k = 0; k < m; k++) {
+            E.set(i, k, integer(int(i * 7 + k * 3) % 11 - 5));
+            F.set(k, i, integer(int(i * 5 + k * 13) % 17 - 8));
+        }
+    }
+    mul_dense_dense(E, F, G);
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned j = 0; j < n; j++) {
+            vec_basic terms;
+            for (unsigned k = 0; k < m; k++) {
+                terms.push_back(mul(E.get(i, k), F.get(k, j)));
+            }
+            REQUIRE(eq(*G.get(i, j), *add(terms)));
+        }
+    }
+}
+
+TEST_CASE("test_modular(): matrices", "[matrices]")
+{
+    const unsigned n = 20;
+    DenseMatrix A = DenseMatrix(n, n);
+    DenseMatrix b = DenseMatrix(n, 2);
+    DenseMatrix x = DenseMatrix(n, 2);
+    DenseMatrix y = DenseMatrix(n, 2);
+    int s = 12345;
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned j = 0; j < n; j++) {
+            s = (s * 1103 + 12345) % 65536;
+            A.set(i, j, integer(s % 2001 - 1000));
+        }
+        b.set(i, 0, integer(i));
+        b.set(i, 1, rational(1, i + 1));
+    }
+    A.set(0, 0, rational(-7, 3));
+
+    REQUIRE(eq(*det_modular(A), *det_bareis(A)));
+    REQUIRE(eq(*A.det(), *det_bareis(A)));
+
+    modular_solve(A, b, x);
+    mul_dense_dense(A, x, y);
+    REQUIRE(y == b);
+
+    x = DenseMatrix(n, 2);
+    A.LU_solve(b, x);
+    mul_dense_dense(A, x, y);
+    REQUIRE(y == b);
+
+    // Singular
+    for (unsigned j = 0; j < n; j++) {
+        A.set(n - 1, j, mul(integer(3), A.get(1, j)));
+    }
+    REQUIRE(eq(*det_modular(A), *integer(0)));
+    CHECK_THROWS_AS(modular_solve(A, b, x), SymEngineException);
+
+    A = DenseMatrix(2, 2, {symbol("a"), integer(1), integer(2), integer(3)});
+    CHECK_THROWS_AS(det_modular(A), SymEngineException);
+}
+
 TEST_CASE("test_dot(): matrices", "[matrices]")
 {
     DenseMatrix A = DenseMatrix(1, 3);
@@ -2146,6 +2278,123 @@ TEST_CASE("test_csr_elementwise_mul(): matrices", "[matrices]")
                           integer(25), integer(36)}));
 }
 
+TEST_CASE("test_csr_LU(): matrices", "[matrices]")
+{
+    CSRMatrix A = CSRMatrix::from_coo(
+        4, 4, {0, 0, 1, 2, 2, 3, 3}, {1, 3, 0, 2, 3, 0, 2},
+        {integer(2), integer(1), integer(3), integer(4), integer(5), integer(1),
+         integer(6)});
+    DenseMatrix D(4, 4);
+    for (unsigned i = 0; i < 4; i++) {
+        for (unsigned j = 0; j < 4; j++) {
+            D.set(i, j, A.get(i, j));
+        }
+    }
+
+    CSRMatrix L, U, LU(4, 4);
+    std::vector<unsigned> p, q;
+    REQUIRE(csr_LU(A, L, U, p, q, true) == 4);
+    L.mul_matrix(U, LU);
+    for (unsigned i = 0; i < 4; i++) {
+        for (unsigned j = 0; j < 4; j++) {
+            REQUIRE(eq(*LU.get(i, j), *A.get(p[i], q[j])));
+        }
+    }
+    REQUIRE(A.rank() == 4);
+    REQUIRE(eq(*A.det(), *D.det()));
+
+    DenseMatrix b(4, 1, {integer(1), integer(2), integer(3), integer(4)});
+    DenseMatrix x(4, 1), y(4, 1);
+    A.LU_solve(b, x);
+    A.mul_matrix(x, y);
+    REQUIRE(y == b);
+
+    DenseMatrix Ainv(4, 4), I(4, 4), Z(4, 4);
+    eye(I);
+    A.inv(Ainv);
+    D.mul_matrix(Ainv, Z);
+    REQUIRE(Z == I);
+
+    CSRMatrix Binv(4, 4);
+    A.inv(Binv);
+    REQUIRE(Binv == Ainv);
+
+    // Natural order LU needs nonzero pivots
+    CHECK_THROWS_AS(A.LU(L, U), SymEngineException);
+    A = CSRMatrix::from_coo(3, 3, {0, 0, 1, 2, 2}, {0, 2, 1, 0, 2},
+                            {integer(2), integer(1), integer(3), integer(4),
+                             integer(5)});
+    A.LU(L, U);
+    REQUIRE(L
+            == CSRMatrix(3, 3, {0, 1, 2, 4}, {0, 1, 0, 2},
+                         {integer(1), integer(1), integer(2), integer(1)}));
+    REQUIRE(U
+            == CSRMatrix(3, 3, {0, 2, 3, 4}, {0, 2, 1, 2},
+                         {integer(2), integer(1), integer(3), integer(3)}));
+
+    // Singular
+    A = CSRMatrix::from_coo(3, 3, {0, 0, 1, 1, 2}, {0, 1, 0, 1, 2},
+                            {integer(1), integer(2), integer(2), integer(4),
+                             integer(7)});
+    REQUIRE(A.rank() == 2);
+    REQUIRE(eq(*A.det(), *integer(0)));
+    DenseMatrix z(3, 1);
+    CHECK_THROWS_AS(A.LU_solve(DenseMatrix(3, 1, {one, one, one}), z),
+                    SymEngineException);
+
+    RCP<const Symbol> a = symbol("a"), c = symbol("c"), d = symbol("d");
+    A = CSRMatrix::from_coo(3, 3, {0, 0, 1, 1, 2, 2}, {0, 1, 1, 2, 0, 2},
+                            {a, one, c, integer(2), d, a});
+    D = DenseMatrix(3, 3, {a, one, integer(0), integer(0), c, integer(2), d,
+                           integer(0), a});
+    REQUIRE(eq(*A.det(), *expand(D.det())));
+
+    // Singular only once the entries are simplified: row 2 is row 0 + row 1
+    RCP<const Symbol> s = symbol("x"), t = symbol("y");
+    A = CSRMatrix(3, 3, {0, 3, 6, 9}, {0, 1, 2, 0, 1, 2, 0, 1, 2},
+                  {s, t, one, one, s, t, add(s, one), add(s, t), add(t, one)});
+    REQUIRE(A.rank() == 2);
+    REQUIRE(eq(*A.det(), *integer(0)));
+    CHECK_THROWS_AS(A.LU_solve(DenseMatrix(3, 1, {one, one, one}), z),
+                    SymEngineException);
+
+    A = CSRMatrix(2, 2, {0, 2, 4}, {0, 1, 0, 1}, {s, t, one, s});
+    DenseMatrix b2(2, 1, {one, s}), x2(2, 1);
+    A.LU_solve(b2, x2);
+    // The solution comes out in lowest terms
+    RCP<const Basic> den = sub(pow(s, integer(2)), t);
+    REQUIRE(eq(*A.det(), *den));
+    REQUIRE(eq(*x2.get(0, 0), *div(sub(s, mul(s, t)), den)));
+    REQUIRE(eq(*x2.get(1, 0), *div(sub(pow(s, integer(2)), one), den)));
+}
+
+TEST_CASE("test_csr_add_mul_matrix(): matrices", "[matrices]")
+{
+    RCP<const Symbol> x = symbol("x");
+    CSRMatrix A = CSRMatrix(2, 3, {0, 2, 3}, {0, 2, 1},
+                            {integer(1), x, integer(3)});
+    CSRMatrix B = CSRMatrix(3, 2, {0, 1, 1, 3}, {1, 0, 1},
+                            {integer(4), integer(5), integer(6)});
+    CSRMatrix C(2, 2), E(2, 3);
+
+    A.mul_matrix(B, C);
+    REQUIRE(C
+            == DenseMatrix(2, 2, {mul(integer(5), x),
+                                  add(integer(4), mul(integer(6), x)),
+                                  integer(0), integer(0)}));
+
+    DenseMatrix F(3, 1, {integer(1), integer(2), integer(3)}), G(2, 1);
+    A.mul_matrix(F, G);
+    REQUIRE(G
+            == DenseMatrix(2, 1,
+                           {add(integer(1), mul(integer(3), x)), integer(6)}));
+
+    A.add_matrix(A, E);
+    REQUIRE(E
+            == CSRMatrix(2, 3, {0, 2, 3}, {0, 2, 1},
+                         {integer(2), mul(integer(2), x), integer(6)}));
+}
+
 TEST_CASE("test_eye(): matrices", "[matrices]")
 {
     DenseMatrix A(3, 3);
@@ -2338,6 +2587,25 @@ TEST_CASE("Test Jacobian", "[matrices]")
     REQUIRE(
         CSRMatrix::jacobian({add(x, mul(integer(-1), y)), mul(x, y)}, {x, y})
         == DenseMatrix(2, 2, {integer(1), integer(-1), y, x}));
+
+    vec_basic exprs{add(x, z), mul(y, z), add(mul(z, x), add(y, t)), t};
+    std::vector<unsigned> p, j;
+    CSRMatrix::jacobian_sparsity(exprs, {x, y, z, x}, p, j);
+    REQUIRE(p == std::vector<unsigned>({0, 3, 5, 9, 9}));
+    REQUIRE(j == std::vector<unsigned>({0, 2, 3, 1, 2, 0, 1, 2, 3}));
+    REQUIRE(CSRMatrix::jacobian(exprs, {x, y, z, x}, p, j)
+            == DenseMatrix(4, 4,
+                           {integer(1), integer(0), integer(1), integer(1),
+                            integer(0), z, y, integer(0), z, integer(1), x, z,
+                            integer(0), integer(0), integer(0), integer(0)}));
+
+    // The pattern can be reused, entries that vanish are kept
+    exprs[0] = add(x, mul(integer(0), z));
+    Js = CSRMatrix::jacobian(exprs, {x, y, z, x}, p, j);
+    std::tie(Js_p1, Js_j1, Js_x1) = Js.as_vectors();
+    REQUIRE(Js_p1 == p);
+    REQUIRE(Js_j1 == j);
+    REQUIRE(eq(*Js_x1[1], *integer(0)));
 }
 
 TEST_CASE("Test Diff", "[matrices]")
@@ -2,21 +2,28 @@
 #include <chrono>
 
 #include <symengine/polys/cancel.h>
+#include <symengine/polys/uintpoly.h>
 #include <symengine/polys/uintpoly_flint.h>
 
 using SymEngine::Basic;
 using SymEngine::cancel;
 using SymEngine::exp;
 using SymEngine::integer;
+using SymEngine::MIntPoly;
 using SymEngine::mul;
 using SymEngine::pow;
+using SymEngine::rational;
 using SymEngine::RCP;
 using SymEngine::sub;
 using SymEngine::symbol;
+using SymEngine::UIntPoly;
+#ifdef HAVE_SYMENGINE_FLINT
 using SymEngine::UIntPolyFlint;
+#endif
 
 using namespace SymEngine::literals;
 
+#ifdef HAVE_SYMENGINE_FLINT
 TEST_CASE("cancel", "[Basic]")
 {
     RCP<const Basic> x = symbol("x");
@@ -58,3 +65,72 @@ TEST_CASE("cancel", "[Basic]")
     REQUIRE(denom->__str__() == "1");
     REQUIRE(common->__str__() == "exp(x) + 1");
 }
+#endif
+
+TEST_CASE("cancel UIntPoly", "[Basic]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const UIntPoly> numer, denom, common;
+
+    cancel(mul(x, integer(2)), x, outArg(numer), outArg(denom), outArg(common));
+    REQUIRE(numer->__str__() == "2");
+    REQUIRE(denom->__str__() == "1");
+    REQUIRE(common->__str__() == "x");
+
+    cancel(sub(mul(x, x), integer(4)), add(x, integer(2)), outArg(numer),
+           outArg(denom), outArg(common));
+    REQUIRE(numer->__str__() == "x - 2");
+    REQUIRE(denom->__str__() == "1");
+    REQUIRE(common->__str__() == "x + 2");
+
+    cancel(sub(pow(x, 3), integer(1)), sub(pow(x, 2), integer(1)),
+           outArg(numer), outArg(denom), outArg(common));
+    REQUIRE(numer->__str__() == "x**2 + x + 1");
+    REQUIRE(denom->__str__() == "x + 1");
+    REQUIRE(common->__str__() == "x - 1");
+
+    // (6*x**2 - 6) / (4*x + 4) = (6*x - 6) / 4
+    cancel(sub(mul(integer(6), pow(x, 2)), integer(6)),
+           add(mul(integer(4), x), integer(4)), outArg(numer), outArg(denom),
+           outArg(common));
+    REQUIRE(numer->__str__() == "3*x - 3");
+    REQUIRE(denom->__str__() == "2");
+    REQUIRE(common->__str__() == "2*x + 2");
+
+    cancel(
+        add(add(exp(mul(integer(2), x)), mul(integer(2), exp(x))), integer(1)),
+        add(exp(x), integer(1)), outArg(numer), outArg(denom), outArg(common));
+    REQUIRE(numer->__str__() == "exp(x) + 1");
+    REQUIRE(denom->__str__() == "1");
+    REQUIRE(common->__str__() == "exp(x) + 1");
+}
+
+TEST_CASE("cancel MIntPoly", "[Basic]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const MIntPoly> numer, denom, common;
+
+    // (x**2 - y**2) / (2*x + 2*y) = (x - y) / 2
+    cancel(sub(pow(x, 2), pow(y, 2)),
+           add(mul(integer(2), x), mul(integer(2), y)), outArg(numer),
+           outArg(denom), outArg(common));
+    REQUIRE(eq(*numer->as_symbolic(), *sub(x, y)));
+    REQUIRE(eq(*denom->as_symbolic(), *integer(2)));
+    REQUIRE(eq(*common->as_symbolic(), *add(x, y)));
+
+    // (x*y + x) / (y**2 - 1) = x / (y - 1)
+    cancel(add(mul(x, y), x), sub(pow(y, 2), integer(1)), outArg(numer),
+           outArg(denom), outArg(common));
+    REQUIRE(eq(*numer->as_symbolic(), *x));
+    REQUIRE(eq(*denom->as_symbolic(), *sub(y, integer(1))));
+    REQUIRE(eq(*common->as_symbolic(), *add(y, integer(1))));
+
+    // the generator sqrt(x) is shared by x and sqrt(x)
+    RCP<const Basic> s = pow(x, rational(1, 2));
+    cancel(sub(x, integer(1)), add(s, integer(1)), outArg(numer),
+           outArg(denom), outArg(common));
+    REQUIRE(eq(*numer->as_symbolic(), *sub(s, integer(1))));
+    REQUIRE(eq(*denom->as_symbolic(), *integer(1)));
+    REQUIRE(eq(*common->as_symbolic(), *add(s, integer(1))));
+}
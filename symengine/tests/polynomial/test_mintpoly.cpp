@@ -578,6 +578,99 @@ TEST_CASE("MIntPoly from_poly", "[MIntPoly]")
 
     REQUIRE(eq(*MIntPoly::from_poly(*upoly), *mpoly));
 }
+
+TEST_CASE("Testing division of MIntPoly", "[MIntPoly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const MIntPoly> a = MIntPoly::from_dict(
+        {x, y}, {{{2, 1}, 1_z}, {{1, 2}, 1_z}, {{0, 2}, 1_z}});
+    RCP<const MIntPoly> b
+        = MIntPoly::from_dict({x, y}, {{{1, 1}, 1_z}, {{0, 0}, -1_z}});
+    RCP<const MIntPoly> q, r;
+
+    // x**2*y + x*y**2 + y**2 = (x + y)*(x*y - 1) + x + y**2 + y
+    divrem_mpoly(*a, *b, outArg(q), outArg(r));
+    REQUIRE(eq(*q, *MIntPoly::from_dict(
+                       {x, y}, {{{1, 0}, 1_z}, {{0, 1}, 1_z}})));
+    REQUIRE(eq(*r, *MIntPoly::from_dict(
+                       {x, y}, {{{1, 0}, 1_z}, {{0, 2}, 1_z}, {{0, 1}, 1_z}})));
+    REQUIRE(not divides_mpoly(*b, *a, outArg(q)));
+
+    // 2*x + 3 = x*2 + 3
+    a = MIntPoly::from_dict({x}, {{{1}, 2_z}, {{0}, 3_z}});
+    b = MIntPoly::from_dict({x}, {{{0}, 2_z}});
+    divrem_mpoly(*a, *b, outArg(q), outArg(r));
+    REQUIRE(eq(*q, *MIntPoly::from_dict({x}, {{{1}, 1_z}})));
+    REQUIRE(eq(*r, *MIntPoly::from_dict({x}, {{{0}, 3_z}})));
+
+    a = MIntPoly::from_dict({x, y}, {{{1, 1}, 3_z}, {{0, 0}, -1_z}});
+    b = MIntPoly::from_dict({x, y}, {{{2, 0}, 1_z}, {{0, 3}, -2_z}});
+    RCP<const MIntPoly> c = mul_mpoly(*a, *b);
+    REQUIRE(divides_mpoly(*a, *c, outArg(q)));
+    REQUIRE(eq(*q, *b));
+    REQUIRE(divides_mpoly(*b, *c, outArg(q)));
+    REQUIRE(eq(*q, *a));
+    REQUIRE(not divides_mpoly(*c, *a, outArg(q)));
+}
+
+TEST_CASE("Testing gcd of MIntPoly", "[MIntPoly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Symbol> z = symbol("z");
+    RCP<const MIntPoly> g = MIntPoly::from_dict(
+        {x, y, z}, {{{1, 1, 0}, 3_z}, {{0, 0, 2}, -2_z}, {{0, 0, 0}, 5_z}});
+    RCP<const MIntPoly> u = MIntPoly::from_dict(
+        {x, y, z}, {{{2, 0, 0}, 4_z}, {{0, 1, 1}, 4_z}, {{0, 0, 0}, -28_z}});
+    RCP<const MIntPoly> v = MIntPoly::from_dict(
+        {x, y, z}, {{{0, 2, 0}, 12_z}, {{1, 0, 1}, 6_z}, {{1, 0, 0}, 6_z}});
+    RCP<const MIntPoly> two
+        = MIntPoly::from_dict({x, y, z}, {{{0, 0, 0}, 2_z}});
+    RCP<const MIntPoly> one_p
+        = MIntPoly::from_dict({x, y, z}, {{{0, 0, 0}, 1_z}});
+
+    RCP<const MIntPoly> a = mul_mpoly(*g, *u), b = mul_mpoly(*g, *v);
+    REQUIRE(eq(*gcd_mpoly(*a, *b), *mul_mpoly(*g, *two)));
+    REQUIRE(eq(*gcd_mpoly(*neg_mpoly(*a), *b), *mul_mpoly(*g, *two)));
+    REQUIRE(eq(*gcd_mpoly(*mul_mpoly(*a, *g), *mul_mpoly(*b, *g)),
+               *mul_mpoly(*pow_mpoly(*g, 2), *two)));
+    REQUIRE(eq(*gcd_mpoly(*u, *v), *two));
+    REQUIRE(eq(*gcd_mpoly(*g, *add_mpoly(*g, *one_p)), *one_p));
+
+    // the result uses the union of the variables
+    a = MIntPoly::from_dict({x, y}, {{{1, 1}, 1_z}, {{1, 0}, 1_z}});
+    b = MIntPoly::from_dict({x}, {{{2}, 1_z}, {{1}, 1_z}});
+    REQUIRE(eq(*gcd_mpoly(*a, *b),
+               *MIntPoly::from_dict({x, y}, {{{1, 0}, 1_z}})));
+}
+TEST_CASE("Testing multiplication of MIntPoly with large exponents",
+          "[MIntPoly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Symbol> z = symbol("z");
+    // the exponent sums need more than 64 bits in total
+    unsigned int e = 2000000000u;
+    RCP<const MIntPoly> p1 = MIntPoly::from_dict(
+        {x, y, z}, {{{e, e, 0}, 1_z}, {{0, 0, e}, 2_z}, {{0, 0, 0}, -1_z}});
+    RCP<const MIntPoly> p2 = MIntPoly::from_dict(
+        {x, y, z}, {{{e, e, 0}, 1_z}, {{0, 0, e}, 2_z}, {{0, 0, 0}, 1_z}});
+    RCP<const MIntPoly> q = MIntPoly::from_dict({x, y, z},
+                                                {{{2 * e, 2 * e, 0}, 1_z},
+                                                 {{e, e, e}, 4_z},
+                                                 {{0, 0, 2 * e}, 4_z},
+                                                 {{0, 0, 0}, -1_z}});
+    REQUIRE(eq(*mul_mpoly(*p1, *p2), *q));
+
+    // terms cancelling in the product
+    p1 = MIntPoly::from_dict({x, y}, {{{1, 0}, 1_z}, {{0, 1}, 1_z}});
+    p2 = MIntPoly::from_dict({x, y}, {{{1, 0}, 1_z}, {{0, 1}, -1_z}});
+    q = MIntPoly::from_dict({x, y}, {{{2, 0}, 1_z}, {{0, 2}, -1_z}});
+    REQUIRE(eq(*mul_mpoly(*p1, *p2), *q));
+    REQUIRE(mul_mpoly(*p1, *p2)->get_poly().dict_.size() == 2);
+}
+
 /*
 TEST_CASE("Testing equality of MultivariateExprPolynomials with Expressions",
           "[MultivariateExprPolynomial],[Expression]")
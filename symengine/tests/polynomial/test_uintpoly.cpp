@@ -270,6 +270,98 @@ TEST_CASE("UIntPoly divides", "[UIntPoly]")
     REQUIRE(divides_upoly(*b, *c, outArg(res)));
     REQUIRE(res->__str__() == "2*x + 2");
     REQUIRE(!divides_upoly(*b, *a, outArg(res)));
+
+    // fewer terms in the dividend than in the divisor
+    a = UIntPoly::from_dict(x, {{0, 1_z}, {1, 1_z}, {2, 1_z}});
+    b = UIntPoly::from_dict(x, {{0, -1_z}, {3, 1_z}});
+    REQUIRE(divides_upoly(*a, *b, outArg(res)));
+    REQUIRE(res->__str__() == "x - 1");
+    REQUIRE(!divides_upoly(*b, *a, outArg(res)));
+}
+
+TEST_CASE("UIntPoly gcd", "[UIntPoly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const UIntPoly> a = UIntPoly::from_dict(x, {{2, 2_z}});
+    RCP<const UIntPoly> b = UIntPoly::from_dict(x, {{1, 3_z}});
+    RCP<const UIntPoly> c
+        = UIntPoly::from_dict(x, {{0, 6_z}, {1, 8_z}, {2, 2_z}});
+    RCP<const UIntPoly> d = UIntPoly::from_dict(x, {{1, 4_z}, {2, 4_z}});
+    RCP<const UIntPoly> e = UIntPoly::from_dict(x, {{0, -2_z}, {1, -2_z}});
+    RCP<const UIntPoly> z = UIntPoly::from_dict(x, map_uint_mpz{});
+
+    REQUIRE(gcd_upoly(*a, *b)->__str__() == "x");
+    REQUIRE(gcd_upoly(*c, *d)->__str__() == "2*x + 2");
+    REQUIRE(gcd_upoly(*a, *d)->__str__() == "2*x");
+    REQUIRE(gcd_upoly(*b, *c)->__str__() == "1");
+    REQUIRE(gcd_upoly(*d, *e)->__str__() == "2*x + 2");
+    REQUIRE(gcd_upoly(*z, *e)->__str__() == "2*x + 2");
+    REQUIRE(gcd_upoly(*z, *z)->__str__() == "0");
+
+    // `l` has coefficients larger than a word, so that the modular
+    // algorithm needs several primes
+    UIntDict g({{0, 100_z}, {1, -7_z}, {3, 12_z}});
+    UIntDict h({{0, 1_z}, {1, 3_z}, {4, 1_z}});
+    UIntDict k({{0, -2_z}, {2, 5_z}});
+    UIntDict l({{0, 100000000000000000001_z}, {2, 100000000000000000000_z}});
+    UIntDict f1 = g * g * h * l * UIntDict(2);
+    UIntDict f2 = g * k * k * l * UIntDict(4);
+    UIntDict expected = g * l * UIntDict(2), res;
+
+    REQUIRE(UIntDict::gcd_heu(f1, f2, res));
+    REQUIRE(res == expected);
+    REQUIRE(UIntDict::gcd_modular(f1, f2) == expected);
+    REQUIRE(UIntDict::gcd_modular(f1, k * k) == UIntDict(1));
+    // one input divides the other, so the first image has the degree bound
+    UIntDict m({{0, -1_z}, {2, 1_z}}), n({{0, -1_z}, {1, 1_z}});
+    REQUIRE(UIntDict::gcd_modular(m, n) == n);
+    REQUIRE(UIntDict::gcd_modular(g * l, l) == l);
+    REQUIRE(UIntDict::gcd(-f2, f1) == expected);
+}
+
+TEST_CASE("UIntPoly lcm", "[UIntPoly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const UIntPoly> a = UIntPoly::from_dict(x, {{2, 6_z}});
+    RCP<const UIntPoly> b = UIntPoly::from_dict(x, {{1, 8_z}});
+    RCP<const UIntPoly> c = UIntPoly::from_dict(x, {{0, 8_z}, {1, 8_z}});
+
+    REQUIRE(lcm_upoly(*a, *b)->__str__() == "24*x**2");
+    REQUIRE(lcm_upoly(*b, *c)->__str__() == "8*x**2 + 8*x");
+    REQUIRE(lcm_upoly(*a, *c)->__str__() == "24*x**3 + 24*x**2");
+}
+
+TEST_CASE("UIntPoly interpolation", "[UIntPoly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    // more points than a single block of the subproduct tree, with values
+    // needing several primes
+    map_uint_mpz d;
+    integer_class c(1);
+    for (unsigned i = 0; i <= 300; i++) {
+        c = (c * 1103515245 + 12345) % 1000003;
+        d[i] = c - 500000;
+    }
+    RCP<const UIntPoly> a = UIntPoly::from_dict(x, std::move(d));
+    vec_integer_class pts;
+    for (int i = -100; i < 150; i++)
+        pts.push_back(integer_class(3 * i + 1));
+
+    // 301 coefficients are determined by as many values
+    pts.resize(301);
+    for (unsigned i = 250; i < 301; i++)
+        pts[i] = integer_class(1000 + i);
+    vec_integer_class vals = a->multieval(pts);
+    REQUIRE(eq(*interpolate_upoly(x, pts, vals), *a));
+    REQUIRE(UIntDict::interpolate({1_z, 2_z, 3_z}, {3_z, 5_z, 7_z})
+            == UIntDict({{0, 1_z}, {1, 2_z}}));
+    REQUIRE(UIntDict::interpolate({}, {}) == UIntDict());
+
+    // x/2 does not have integer coefficients
+    CHECK_THROWS_AS(UIntDict::interpolate({0_z, 2_z}, {0_z, 1_z}),
+                    SymEngineException);
+    CHECK_THROWS_AS(UIntDict::interpolate({1_z, 1_z}, {0_z, 1_z}),
+                    SymEngineException);
 }
 
 #ifdef HAVE_SYMENGINE_PIRANHA
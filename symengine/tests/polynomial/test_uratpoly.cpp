@@ -261,6 +261,42 @@ TEST_CASE("URatPoly divides", "[URatPoly]")
     REQUIRE(divides_upoly(*b, *a, outArg(res)));
     REQUIRE(res->__str__() == "1/4*x + 1/4");
     REQUIRE(!divides_upoly(*a, *b, outArg(res)));
+
+    a = URatPoly::from_dict(x, {{0, 1_q}, {1, 1_q}, {2, 1_q}});
+    b = URatPoly::from_dict(x, {{0, rc(-1_z, 2_z)}, {3, rc(1_z, 2_z)}});
+    REQUIRE(divides_upoly(*a, *b, outArg(res)));
+    REQUIRE(res->__str__() == "1/2*x - 1/2");
+}
+
+TEST_CASE("URatPoly gcd", "[URatPoly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const URatPoly> a = URatPoly::from_dict(x, {{2, 2_q}});
+    RCP<const URatPoly> b = URatPoly::from_dict(x, {{1, 3_q}});
+    RCP<const URatPoly> c
+        = URatPoly::from_dict(x, {{0, 6_q}, {1, 8_q}, {2, 2_q}});
+    RCP<const URatPoly> d = URatPoly::from_dict(x, {{1, 4_q}, {2, 4_q}});
+    RCP<const URatPoly> e
+        = URatPoly::from_dict(x, {{0, rc(1_z, 3_z)}, {1, rc(2_z, 3_z)}});
+
+    REQUIRE(gcd_upoly(*a, *b)->__str__() == "x");
+    REQUIRE(gcd_upoly(*c, *d)->__str__() == "x + 1");
+    REQUIRE(gcd_upoly(*a, *d)->__str__() == "x");
+    REQUIRE(gcd_upoly(*b, *c)->__str__() == "1");
+    REQUIRE(gcd_upoly(*a, *e)->__str__() == "1");
+    REQUIRE(gcd_upoly(*e, *e)->__str__() == "x + 1/2");
+}
+
+TEST_CASE("URatPoly lcm", "[URatPoly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const URatPoly> a = URatPoly::from_dict(x, {{2, 6_q}});
+    RCP<const URatPoly> b = URatPoly::from_dict(x, {{1, 8_q}});
+    RCP<const URatPoly> c = URatPoly::from_dict(x, {{0, 8_q}, {1, 8_q}});
+
+    REQUIRE(lcm_upoly(*a, *b)->__str__() == "x**2");
+    REQUIRE(lcm_upoly(*b, *c)->__str__() == "x**2 + x");
+    REQUIRE(lcm_upoly(*a, *c)->__str__() == "x**3 + x**2");
 }
 
 TEST_CASE("URatPoly from_poly uint", "[URatPoly]")
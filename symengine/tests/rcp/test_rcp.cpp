@@ -1,6 +1,8 @@
 #include "catch.hpp"
 
 #include <symengine/symengine_rcp.h>
+#include <vector>
+#include <thread>
 
 using SymEngine::EnableRCPFromThis;
 using SymEngine::make_rcp;
@@ -110,3 +112,50 @@ TEST_CASE("Test rcp_from_this const 2", "[rcp]")
     f2_hybrid(*m2);
     REQUIRE(m2->use_count() == 1);
 }
+
+#if defined(WITH_SYMENGINE_POOL_ALLOCATOR)
+TEST_CASE("Test pool allocator", "[rcp]")
+{
+    // Freed blocks are reused by the next allocation of the same size class
+    void *p = SymEngine::pool_allocate(40);
+    SymEngine::pool_deallocate(p, 40);
+    void *q = SymEngine::pool_allocate(48);
+    REQUIRE(p == q);
+    SymEngine::pool_deallocate(q, 48);
+
+    // Large requests bypass the pools
+    p = SymEngine::pool_allocate(1000);
+    SymEngine::pool_deallocate(p, 1000);
+
+    RCP<Mesh> m = make_rcp<Mesh>();
+    m->x = 5;
+    m->y = 7;
+    REQUIRE(m->x + m->y == 12);
+    m.reset();
+
+    std::vector<int, SymEngine::PoolAllocator<int>> v;
+    for (int i = 0; i < 1000; i++)
+        v.push_back(i);
+    REQUIRE(v[999] == 999);
+}
+
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+TEST_CASE("Test pool allocator with exiting threads", "[rcp]")
+{
+    // The free blocks of a thread are handed over when it exits, and a new
+    // thread starts with empty free lists
+    void *p = nullptr, *q = nullptr;
+    std::thread t([&p]() {
+        p = SymEngine::pool_allocate(250);
+        SymEngine::pool_deallocate(p, 250);
+    });
+    t.join();
+    std::thread u([&q]() {
+        q = SymEngine::pool_allocate(250);
+        SymEngine::pool_deallocate(q, 250);
+    });
+    u.join();
+    REQUIRE(p == q);
+}
+#endif
+#endif
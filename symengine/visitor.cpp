@@ -98,6 +98,9 @@ public:
     void bvisit(const Basic &x)
     {
         for (const auto &p : x.get_args()) {
+            if (p->symbol_signature() == symbol_free_signature) {
+                continue;
+            }
             auto iter = v.insert(p->rcp_from_this());
             if (iter.second) {
                 p->accept(*this);
@@ -121,6 +121,10 @@ public:
     {
         has_ = false;
         stop_ = false;
+        if (is_a_sub<Symbol>(*x_)
+            and (b.symbol_signature() & symbol_signature_bit(*x_)) == 0) {
+            return has_;
+        }
         preorder_traversal_stop(b, *this);
         return has_;
     }